@@ -25,12 +25,65 @@
 #include <vector>
 #include <string>
 #include <cstring>
+#include <new>
+#include <map>
 
 #include "PAssert.h"
 #include "FieldValue.h"
 #include "GridCoordinate3D.h"
 #include "Settings.h"
 
+/**
+ * Alignment of raw field values buffers in bytes for small buffers (cache line)
+ */
+#define GRID_ALIGNMENT_CACHE_LINE (64)
+
+/**
+ * Alignment of raw field values buffers in bytes for large buffers (page)
+ */
+#define GRID_ALIGNMENT_PAGE (4096)
+
+/**
+ * Allocate contiguous aligned buffer of field values and set all of them to zero.
+ * Buffers, which are larger than page, are aligned to page boundary, others to cache line boundary.
+ *
+ * @return pointer to allocated buffer
+ */
+inline
+FieldValue *
+allocAlignedFieldValues (grid_coord count) /**< number of field values */
+{
+  ASSERT (count > 0);
+
+  size_t bytes = ((size_t) count) * sizeof (FieldValue);
+  size_t alignment = bytes >= GRID_ALIGNMENT_PAGE ? GRID_ALIGNMENT_PAGE : GRID_ALIGNMENT_CACHE_LINE;
+
+  void *ptr = NULLPTR;
+  int status = posix_memalign (&ptr, alignment, bytes);
+  ALWAYS_ASSERT (status == 0 && ptr != NULLPTR);
+
+  FieldValue *data = (FieldValue *) ptr;
+  for (grid_coord i = 0; i < count; ++i)
+  {
+    new (data + i) FieldValue (FIELDVALUE (0, 0));
+  }
+
+  return data;
+} /* allocAlignedFieldValues */
+
+/**
+ * Free buffer, allocated with allocAlignedFieldValues
+ */
+inline
+void
+freeAlignedFieldValues (FieldValue *data) /**< pointer to buffer */
+{
+  /*
+   * FieldValue has no-op destructor, so memory could be just released
+   */
+  ::free (data);
+} /* freeAlignedFieldValues */
+
 /**
  * Storage of FieldValue in N-dimensional mode
  */
@@ -63,11 +116,7 @@ private:
   void alloc ()
   {
     ASSERT (data == NULLPTR);
-    data = new FieldValue[size.get1 ()];
-    for (grid_coord i = 0; i < size.get1 (); ++i)
-    {
-      data[i] = FIELDVALUE (0, 0);
-    }
+    data = allocAlignedFieldValues (size.get1 ());
   } /* alloc */
 
   /**
@@ -76,7 +125,7 @@ private:
   void free ()
   {
     ASSERT (data != NULLPTR);
-    delete[] data;
+    freeAlignedFieldValues (data);
     data = NULLPTR;
   } /* free */
 
@@ -230,6 +279,37 @@ public:
     data[coord.get1 ()] = val;
   } /* set */
 
+  /**
+   * Get linear index of coordinate in raw buffer
+   *
+   * @return linear index
+   */
+  grid_coord calculateIndex (const GridCoordinate1D & coord) const /**< coordinate */
+  {
+    return calculateIndex (coord, size);
+  } /* calculateIndex */
+
+  /**
+   * Get linear index of coordinate in raw buffer of specified size
+   *
+   * @return linear index
+   */
+  static grid_coord calculateIndex (const GridCoordinate1D & coord, /**< coordinate */
+                                    const GridCoordinate1D & size) /**< size of raw buffer */
+  {
+    return coord.get1 ();
+  } /* calculateIndex */
+
+  /**
+   * Get pointer to raw contiguous buffer
+   *
+   * @return pointer to raw buffer
+   */
+  FieldValue * getRawData ()
+  {
+    return data;
+  } /* getRawData */
+
   /**
    * Get size of storage
    *
@@ -270,6 +350,43 @@ public:
     alloc ();
   } /* resizeAndEmpty */
 
+  /**
+   * Get end coordinate for iteration over first points of rows (last coordinate is equal to the one of start)
+   * in [start, end) box. Each such row is contiguous in raw buffer.
+   *
+   * @return end coordinate
+   */
+  static GridCoordinate1D getRowStartsEnd (const GridCoordinate1D &start, /**< start coordinate */
+                                           const GridCoordinate1D &end) /**< end coordinate */
+  {
+    return GRID_COORDINATE_1D (start.get1 () + 1, end.getType1 ());
+  } /* getRowStartsEnd */
+
+  /**
+   * Get length of rows in [start, end) box
+   *
+   * @return length of rows
+   */
+  static grid_coord getRowLength (const GridCoordinate1D &start, /**< start coordinate */
+                                  const GridCoordinate1D &end) /**< end coordinate */
+  {
+    return end.get1 () - start.get1 ();
+  } /* getRowLength */
+
+  /**
+   * Get coordinate of point with specified linear index in [start, end) box. Points are enumerated
+   * in the same order, in which Iterator passes them, so this allows to split box between threads.
+   *
+   * @return coordinate
+   */
+  static GridCoordinate1D getPosition (const GridCoordinate1D &start, /**< start coordinate */
+                                       const GridCoordinate1D &end, /**< end coordinate */
+                                       grid_coord index) /**< linear index of point in box */
+  {
+    ASSERT (index >= 0 && index < end.get1 () - start.get1 ());
+    return GRID_COORDINATE_1D (start.get1 () + index, start.getType1 ());
+  } /* getPosition */
+
   /**
    * Get begin iterator
    *
@@ -303,9 +420,9 @@ class VectorFieldValues<GridCoordinate2D>
   GridCoordinate2D size;
 
   /**
-   * Pointer to raw data
+   * Pointer to raw data. Values are stored contiguously, second coordinate is the fastest.
    */
-  FieldValue **data;
+  FieldValue *data;
 
 private:
 
@@ -315,16 +432,7 @@ private:
   void alloc ()
   {
     ASSERT (data == NULLPTR);
-    data = new FieldValue *[size.get1 ()];
-    for (grid_coord i = 0; i < size.get1 (); ++i)
-    {
-      data[i] = new FieldValue[size.get2 ()];
-
-      for (grid_coord j = 0; j < size.get2 (); ++j)
-      {
-        data[i][j] = FIELDVALUE (0, 0);
-      }
-    }
+    data = allocAlignedFieldValues (size.calculateTotalCoord ());
   } /* alloc */
 
   /**
@@ -333,13 +441,7 @@ private:
   void free ()
   {
     ASSERT (data != NULLPTR);
-    for (grid_coord i = 0; i < size.get1 (); ++i)
-    {
-      ASSERT (data[i] != NULLPTR);
-      delete[] data[i];
-      data[i] = NULLPTR;
-    }
-    delete[] data;
+    freeAlignedFieldValues (data);
     data = NULLPTR;
   } /* free */
 
@@ -499,7 +601,7 @@ public:
    */
   FieldValue * get(const GridCoordinate2D & coord) /**< coordinate */
   {
-    return &data[coord.get1 ()][coord.get2 ()];
+    return &data[calculateIndex (coord)];
   } /* get */
 
   /**
@@ -508,9 +610,61 @@ public:
   void set (const GridCoordinate2D & coord, /**< coordinate */
             const FieldValue & val) /**< field value */
   {
-    data[coord.get1 ()][coord.get2 ()] = val;
+    data[calculateIndex (coord)] = val;
   } /* set */
 
+  /**
+   * Get linear index of coordinate in raw buffer
+   *
+   * @return linear index
+   */
+  grid_coord calculateIndex (const GridCoordinate2D & coord) const /**< coordinate */
+  {
+    return calculateIndex (coord, size);
+  } /* calculateIndex */
+
+  /**
+   * Get linear index of coordinate in raw buffer of specified size
+   *
+   * @return linear index
+   */
+  static grid_coord calculateIndex (const GridCoordinate2D & coord, /**< coordinate */
+                                    const GridCoordinate2D & size) /**< size of raw buffer */
+  {
+    return coord.get1 () * size.get2 () + coord.get2 ();
+  } /* calculateIndex */
+
+  /**
+   * Get pointer to raw contiguous buffer
+   *
+   * @return pointer to raw buffer
+   */
+  FieldValue * getRawData ()
+  {
+    return data;
+  } /* getRawData */
+
+  /**
+   * Get pointer to the start of contiguous row with fixed first coordinate
+   *
+   * @return pointer to row
+   */
+  FieldValue * getRow (grid_coord i) /**< first coordinate */
+  {
+    ASSERT (i >= 0 && i < size.get1 ());
+    return data + i * size.get2 ();
+  } /* getRow */
+
+  /**
+   * Get distance in raw buffer between values, which differ by one in first coordinate
+   *
+   * @return stride of first coordinate
+   */
+  grid_coord getStride1 () const
+  {
+    return size.get2 ();
+  } /* getStride1 */
+
   /**
    * Get size of storage
    *
@@ -527,10 +681,7 @@ public:
   void copy (VectorFieldValues<GridCoordinate2D> *values) /**< raw values to copy */
   {
     ASSERT (size == values->size);
-    for (grid_coord i = 0; i < size.get1 (); ++i)
-    {
-      memcpy (data[i], values->data[i], size.get2 () * sizeof (FieldValue));
-    }
+    memcpy (data, values->data, size.calculateTotalCoord () * sizeof (FieldValue));
   } /* copy */
 
   /**
@@ -538,12 +689,10 @@ public:
    */
   void initialize (const FieldValue & val) /**< value to initialize all field values with */
   {
-    for (grid_coord i = 0; i < size.get1 (); ++i)
+    grid_coord count = size.calculateTotalCoord ();
+    for (grid_coord i = 0; i < count; ++i)
     {
-      for (grid_coord j = 0; j < size.get2 (); ++j)
-      {
-        data[i][j] = val;
-      }
+      data[i] = val;
     }
   } /* initialize */
 
@@ -557,6 +706,46 @@ public:
     alloc ();
   } /* resizeAndEmpty */
 
+  /**
+   * Get end coordinate for iteration over first points of rows (last coordinate is equal to the one of start)
+   * in [start, end) box. Each such row is contiguous in raw buffer.
+   *
+   * @return end coordinate
+   */
+  static GridCoordinate2D getRowStartsEnd (const GridCoordinate2D &start, /**< start coordinate */
+                                           const GridCoordinate2D &end) /**< end coordinate */
+  {
+    return GRID_COORDINATE_2D (end.get1 (), start.get2 () + 1, end.getType1 (), end.getType2 ());
+  } /* getRowStartsEnd */
+
+  /**
+   * Get length of rows in [start, end) box
+   *
+   * @return length of rows
+   */
+  static grid_coord getRowLength (const GridCoordinate2D &start, /**< start coordinate */
+                                  const GridCoordinate2D &end) /**< end coordinate */
+  {
+    return end.get2 () - start.get2 ();
+  } /* getRowLength */
+
+  /**
+   * Get coordinate of point with specified linear index in [start, end) box. Points are enumerated
+   * in the same order, in which Iterator passes them, so this allows to split box between threads.
+   *
+   * @return coordinate
+   */
+  static GridCoordinate2D getPosition (const GridCoordinate2D &start, /**< start coordinate */
+                                       const GridCoordinate2D &end, /**< end coordinate */
+                                       grid_coord index) /**< linear index of point in box */
+  {
+    grid_coord size2 = end.get2 () - start.get2 ();
+    ASSERT (index >= 0 && index < (end.get1 () - start.get1 ()) * size2);
+    return GRID_COORDINATE_2D (start.get1 () + index / size2,
+                               start.get2 () + index % size2,
+                               start.getType1 (), start.getType2 ());
+  } /* getPosition */
+
   /**
    * Get begin iterator
    *
@@ -590,9 +779,9 @@ class VectorFieldValues<GridCoordinate3D>
   GridCoordinate3D size;
 
   /**
-   * Pointer to raw data
+   * Pointer to raw data. Values are stored contiguously, third coordinate is the fastest.
    */
-  FieldValue ***data;
+  FieldValue *data;
 
 private:
 
@@ -602,20 +791,7 @@ private:
   void alloc ()
   {
     ASSERT (data == NULLPTR);
-    data = new FieldValue **[size.get1 ()];
-    for (grid_coord i = 0; i < size.get1 (); ++i)
-    {
-      data[i] = new FieldValue *[size.get2 ()];
-      for (grid_coord j = 0; j < size.get2 (); ++j)
-      {
-        data[i][j] = new FieldValue [size.get3 ()];
-
-        for (grid_coord k = 0; k < size.get3 (); ++k)
-        {
-          data[i][j][k] = FIELDVALUE (0, 0);
-        }
-      }
-    }
+    data = allocAlignedFieldValues (size.calculateTotalCoord ());
   } /* alloc */
 
   /**
@@ -624,19 +800,7 @@ private:
   void free ()
   {
     ASSERT (data != NULLPTR);
-    for (grid_coord i = 0; i < size.get1 (); ++i)
-    {
-      ASSERT (data[i] != NULLPTR);
-      for (grid_coord j = 0; j < size.get2 (); ++j)
-      {
-        ASSERT (data[i][j] != NULLPTR);
-        delete[] data[i][j];
-        data[i][j] = NULLPTR;
-      }
-      delete[] data[i];
-      data[i] = NULLPTR;
-    }
-    delete[] data;
+    freeAlignedFieldValues (data);
     data = NULLPTR;
   } /* free */
 
@@ -814,7 +978,7 @@ public:
    */
   FieldValue * get(const GridCoordinate3D & coord) /**< coordinate */
   {
-    return &data[coord.get1 ()][coord.get2 ()][coord.get3 ()];
+    return &data[calculateIndex (coord)];
   } /* get */
 
   /**
@@ -823,9 +987,73 @@ public:
   void set (const GridCoordinate3D & coord, /**< coordinate */
             const FieldValue & val) /**< field value */
   {
-    data[coord.get1 ()][coord.get2 ()][coord.get3 ()] = val;
+    data[calculateIndex (coord)] = val;
   } /* set */
 
+  /**
+   * Get linear index of coordinate in raw buffer
+   *
+   * @return linear index
+   */
+  grid_coord calculateIndex (const GridCoordinate3D & coord) const /**< coordinate */
+  {
+    return calculateIndex (coord, size);
+  } /* calculateIndex */
+
+  /**
+   * Get linear index of coordinate in raw buffer of specified size
+   *
+   * @return linear index
+   */
+  static grid_coord calculateIndex (const GridCoordinate3D & coord, /**< coordinate */
+                                    const GridCoordinate3D & size) /**< size of raw buffer */
+  {
+    return (coord.get1 () * size.get2 () + coord.get2 ()) * size.get3 () + coord.get3 ();
+  } /* calculateIndex */
+
+  /**
+   * Get pointer to raw contiguous buffer
+   *
+   * @return pointer to raw buffer
+   */
+  FieldValue * getRawData ()
+  {
+    return data;
+  } /* getRawData */
+
+  /**
+   * Get pointer to the start of contiguous row with fixed first and second coordinates
+   *
+   * @return pointer to row
+   */
+  FieldValue * getRow (grid_coord i, /**< first coordinate */
+                       grid_coord j) /**< second coordinate */
+  {
+    ASSERT (i >= 0 && i < size.get1 ());
+    ASSERT (j >= 0 && j < size.get2 ());
+    return data + (i * size.get2 () + j) * size.get3 ();
+  } /* getRow */
+
+  /**
+   * Get distance in raw buffer between values, which differ by one in first coordinate
+   *
+   * @return stride of first coordinate
+   */
+  grid_coord getStride1 () const
+  {
+    return size.get2 () * size.get3 ();
+  } /* getStride1 */
+
+  /**
+   * Get distance in raw buffer between values, which differ by one in second coordinate
+   *
+   * @return stride of second coordinate
+   */
+  grid_coord getStride2 () const
+  {
+    return size.get3 ();
+  } /* getStride2 */
+
   /**
    * Get size of storage
    *
@@ -842,13 +1070,7 @@ public:
   void copy (VectorFieldValues<GridCoordinate3D> *values) /**< raw values to copy */
   {
     ASSERT (size == values->size);
-    for (grid_coord i = 0; i < size.get1 (); ++i)
-    {
-      for (grid_coord j = 0; j < size.get2 (); ++j)
-      {
-        memcpy (data[i][j], values->data[i][j], size.get3 () * sizeof (FieldValue));
-      }
-    }
+    memcpy (data, values->data, size.calculateTotalCoord () * sizeof (FieldValue));
   } /* copy */
 
   /**
@@ -856,15 +1078,10 @@ public:
    */
   void initialize (const FieldValue & val) /**< value to initialize all field values with */
   {
-    for (grid_coord i = 0; i < size.get1 (); ++i)
+    grid_coord count = size.calculateTotalCoord ();
+    for (grid_coord i = 0; i < count; ++i)
     {
-      for (grid_coord j = 0; j < size.get2 (); ++j)
-      {
-        for (grid_coord k = 0; k < size.get3 (); ++k)
-        {
-          data[i][j][k] = val;
-        }
-      }
+      data[i] = val;
     }
   } /* initialize */
 
@@ -878,6 +1095,49 @@ public:
     alloc ();
   } /* resizeAndEmpty */
 
+  /**
+   * Get end coordinate for iteration over first points of rows (last coordinate is equal to the one of start)
+   * in [start, end) box. Each such row is contiguous in raw buffer.
+   *
+   * @return end coordinate
+   */
+  static GridCoordinate3D getRowStartsEnd (const GridCoordinate3D &start, /**< start coordinate */
+                                           const GridCoordinate3D &end) /**< end coordinate */
+  {
+    return GRID_COORDINATE_3D (end.get1 (), end.get2 (), start.get3 () + 1,
+                               end.getType1 (), end.getType2 (), end.getType3 ());
+  } /* getRowStartsEnd */
+
+  /**
+   * Get length of rows in [start, end) box
+   *
+   * @return length of rows
+   */
+  static grid_coord getRowLength (const GridCoordinate3D &start, /**< start coordinate */
+                                  const GridCoordinate3D &end) /**< end coordinate */
+  {
+    return end.get3 () - start.get3 ();
+  } /* getRowLength */
+
+  /**
+   * Get coordinate of point with specified linear index in [start, end) box. Points are enumerated
+   * in the same order, in which Iterator passes them, so this allows to split box between threads.
+   *
+   * @return coordinate
+   */
+  static GridCoordinate3D getPosition (const GridCoordinate3D &start, /**< start coordinate */
+                                       const GridCoordinate3D &end, /**< end coordinate */
+                                       grid_coord index) /**< linear index of point in box */
+  {
+    grid_coord size2 = end.get2 () - start.get2 ();
+    grid_coord size3 = end.get3 () - start.get3 ();
+    ASSERT (index >= 0 && index < (end.get1 () - start.get1 ()) * size2 * size3);
+    return GRID_COORDINATE_3D (start.get1 () + index / (size2 * size3),
+                               start.get2 () + (index / size3) % size2,
+                               start.get3 () + index % size3,
+                               start.getType1 (), start.getType2 (), start.getType3 ());
+  } /* getPosition */
+
   /**
    * Get begin iterator
    *
@@ -899,6 +1159,26 @@ public:
   } /* end */
 }; /* VectorFieldValues */
 
+/**
+ * Order of field values, which is used to find distinct values of grid
+ */
+struct FieldValueLess
+{
+  bool operator () (const FieldValue &lhs, const FieldValue &rhs) const
+  {
+#ifdef COMPLEX_FIELD_VALUES
+    return lhs.real () < rhs.real () || (lhs.real () == rhs.real () && lhs.imag () < rhs.imag ());
+#else /* COMPLEX_FIELD_VALUES */
+    return lhs < rhs;
+#endif /* !COMPLEX_FIELD_VALUES */
+  }
+}; /* FieldValueLess */
+
+/**
+ * Maximum number of distinct values in compact grid
+ */
+#define GRID_COMPACT_MAX_VALUES (65536)
+
 /**
  * Non-parallel grid class.
  */
@@ -922,6 +1202,44 @@ protected:
    */
   std::string gridName;
 
+  /**
+   * Table of distinct values of compact grid (see compact)
+   */
+  std::vector<FieldValue> compactValues;
+
+  /**
+   * Indexes of values in table for each point of compact grid. Only one of these is used, depending on the number
+   * of distinct values, and none is used if grid has a single value.
+   */
+  std::vector<uint8_t> compactIndexes8;
+  std::vector<uint16_t> compactIndexes16;
+
+  /**
+   * Flag whether grid is compact, i.e. its values are stored as indexes in table of distinct values
+   */
+  bool isCompact;
+
+  /**
+   * Flag whether grid is updated in place, i.e. all time layers of grid share the same values
+   */
+  bool isInPlace;
+
+  /**
+   * Start and end coordinates of boxes, in which values of partial grid are stored
+   */
+  std::vector<TCoord> partialStart;
+  std::vector<TCoord> partialEnd;
+
+  /**
+   * Values of partial grid for each time layer and each box
+   */
+  std::vector< std::vector<VectorFieldValues<TCoord> *> > partialValues;
+
+  /**
+   * Flag whether grid is partial, i.e. its values are stored only for points in some boxes (see constructor)
+   */
+  bool isPartial;
+
   /*
    * TODO: add debug uninitialized flag
    */
@@ -939,9 +1257,13 @@ protected:
 
   bool isLegitIndex (const TCoord &) const;
 
+  FieldValue * getPartialFieldValue (const TCoord &, int);
+
 public:
 
   Grid (const TCoord&, int, const char * = "unnamed");
+  Grid (const TCoord&, int, bool, const char *);
+  Grid (const TCoord&, int, const std::vector<TCoord> &, const std::vector<TCoord> &, const char *);
   Grid (int, const char * = "unnamed");
   virtual ~Grid ();
 
@@ -982,6 +1304,18 @@ public:
 
   const char * getName () const;
 
+  bool compact ();
+
+  /**
+   * Check whether grid is compact
+   *
+   * @return true, if grid is compact
+   */
+  bool getIsCompact () const
+  {
+    return isCompact;
+  } /* getIsCompact */
+
   void initialize (const FieldValue &);
 
   VectorFieldValues<TCoord> * getRaw (int);
@@ -993,12 +1327,49 @@ public:
     return gridValues.size ();
   }
 
+  /**
+   * Get number of time layers, for which memory is allocated
+   *
+   * @return number of allocated time layers
+   */
+  int getCountAllocatedSteps () const
+  {
+    return isInPlace ? 1 : gridValues.size ();
+  } /* getCountAllocatedSteps */
+
+  /**
+   * Check whether grid is updated in place
+   *
+   * @return true, if all time layers of grid share the same values
+   */
+  bool getIsInPlace () const
+  {
+    return isInPlace;
+  } /* getIsInPlace */
+
+  /**
+   * Check whether grid is partial
+   *
+   * @return true, if values of grid are stored only for points in some boxes
+   */
+  bool getIsPartial () const
+  {
+    return isPartial;
+  } /* getIsPartial */
+
+  bool isStored (const TCoord &);
+
+  grid_coord getCountAllocatedValues () const;
+
   void copy (const Grid<TCoord> *grid)
   {
+    ASSERT (!isCompact && !grid->isCompact);
+    ASSERT (!isPartial && !grid->isPartial);
+    ASSERT (isInPlace == grid->isInPlace);
     ASSERT (size == grid->size);
     ASSERT (gridValues.size () == grid->gridValues.size ());
 
-    for (int i = 0; i < gridValues.size (); ++i)
+    for (int i = 0; i < getCountAllocatedSteps (); ++i)
     {
       gridValues[i]->copy (grid->gridValues[i]);
     }
@@ -1015,6 +1386,9 @@ Grid<TCoord>::Grid (const TCoord &s, /**< size of grid */
   : size (s)
   , gridValues (storedSteps)
   , gridName (name)
+  , isCompact (false)
+  , isInPlace (false)
+  , isPartial (false)
 {
   ASSERT (storedSteps > 0);
 
@@ -1027,6 +1401,88 @@ Grid<TCoord>::Grid (const TCoord &s, /**< size of grid */
     gridName.data (), (grid_coord) gridValues.size (), size.calculateTotalCoord ());
 } /* Grid<TCoord>::Grid */
 
+/**
+ * Constructor of grid, which could be updated in place. Such grid allocates memory for a single time layer, and all
+ * its time layers share the same values, so that shift in time is no-op. This is possible for grids, each point of
+ * which depends only on its own previous value (and on values of other grids), e.g. E and H in Yee scheme: previous
+ * value of point is read right before it is overwritten with the new one.
+ */
+template <class TCoord>
+Grid<TCoord>::Grid (const TCoord &s, /**< size of grid */
+                    int storedSteps, /**< number of steps in time for which to store grid values */
+                    bool inPlace, /**< flag whether to update grid in place */
+                    const char *name) /**< name of grid */
+  : size (s)
+  , gridValues (storedSteps)
+  , gridName (name)
+  , isCompact (false)
+  , isInPlace (inPlace)
+  , isPartial (false)
+{
+  ASSERT (storedSteps > 0);
+
+  for (int i = 0; i < gridValues.size (); ++i)
+  {
+    gridValues[i] = isInPlace && i > 0 ? gridValues[0] : new VectorFieldValues<TCoord> (size);
+  }
+
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "New grid '%s' with " C_MOD " stored steps (" C_MOD " allocated) and raw size: " C_MOD ".\n",
+    gridName.data (), (grid_coord) gridValues.size (), (grid_coord) getCountAllocatedSteps (), size.calculateTotalCoord ());
+} /* Grid<TCoord>::Grid */
+
+/**
+ * Constructor of partial grid, values of which are stored only for points in specified boxes. Values of other points
+ * should never be accessed, e.g. auxiliary fields of PML are needed only in PML. Boxes should not intersect. Each box
+ * is stored separately, so rows of points of each box are contiguous.
+ */
+template <class TCoord>
+Grid<TCoord>::Grid (const TCoord &s, /**< size of grid */
+                    int storedSteps, /**< number of steps in time for which to store grid values */
+                    const std::vector<TCoord> &boxStart, /**< start coordinates of boxes */
+                    const std::vector<TCoord> &boxEnd, /**< end coordinates of boxes */
+                    const char *name) /**< name of grid */
+  : size (s)
+  , gridValues (storedSteps)
+  , gridName (name)
+  , isCompact (false)
+  , isInPlace (false)
+  , partialValues (storedSteps)
+  , isPartial (true)
+{
+  ASSERT (storedSteps > 0);
+  ASSERT (boxStart.size () == boxEnd.size ());
+
+  for (size_t j = 0; j < boxStart.size (); ++j)
+  {
+    /*
+     * Empty boxes are not stored
+     */
+    if (!(boxStart[j] < boxEnd[j]))
+    {
+      continue;
+    }
+
+    ASSERT (boxEnd[j] <= size);
+
+    partialStart.push_back (boxStart[j]);
+    partialEnd.push_back (boxEnd[j]);
+  }
+
+  for (int i = 0; i < gridValues.size (); ++i)
+  {
+    gridValues[i] = NULLPTR;
+
+    partialValues[i].resize (partialStart.size ());
+    for (size_t j = 0; j < partialStart.size (); ++j)
+    {
+      partialValues[i][j] = new VectorFieldValues<TCoord> (partialEnd[j] - partialStart[j]);
+    }
+  }
+
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "New partial grid '%s' with " C_MOD " stored steps and raw size: " C_MOD " (" C_MOD " stored).\n",
+    gridName.data (), (grid_coord) gridValues.size (), size.calculateTotalCoord (), getCountAllocatedValues () / (grid_coord) gridValues.size ());
+} /* Grid<TCoord>::Grid */
+
 /**
  * Constructor of grid without size
  */
@@ -1035,6 +1491,9 @@ Grid<TCoord>::Grid (int storedSteps, /**< number of steps in time for which to s
                     const char *name) /**< name of grid */
   : gridValues (storedSteps)
   , gridName (name)
+  , isCompact (false)
+  , isInPlace (false)
+  , isPartial (false)
 {
   ASSERT (storedSteps > 0);
 
@@ -1053,11 +1512,20 @@ Grid<TCoord>::Grid (int storedSteps, /**< number of steps in time for which to s
 template <class TCoord>
 Grid<TCoord>::~Grid ()
 {
-  for (int i = 0; i < gridValues.size (); ++i)
+  for (int i = 0; i < getCountAllocatedSteps (); ++i)
   {
     delete gridValues[i];
     gridValues[i] = NULLPTR;
   }
+
+  for (int i = 0; i < partialValues.size (); ++i)
+  {
+    for (size_t j = 0; j < partialValues[i].size (); ++j)
+    {
+      delete partialValues[i][j];
+      partialValues[i][j] = NULLPTR;
+    }
+  }
 } /* Grid<TCoord>::~Grid */
 
 
@@ -1133,10 +1601,79 @@ Grid<TCoord>::setFieldValue (const FieldValue & value, /**< field point value */
 {
   ASSERT (isLegitIndex (position));
   ASSERT (time_step_back < gridValues.size ());
+  ASSERT (!isCompact);
+
+  if (isPartial)
+  {
+    *getPartialFieldValue (position, time_step_back) = value;
+    return;
+  }
 
   gridValues[time_step_back]->set (position, value);
 } /* Grid<TCoord>::setFieldValue */
 
+/**
+ * Get field value at coordinate in partial grid
+ *
+ * @return field value or null, if value of point is not stored
+ */
+template <class TCoord>
+FieldValue *
+Grid<TCoord>::getPartialFieldValue (const TCoord &position, /**< coordinate in grid */
+                                    int time_step_back) /**< index of previous time step, starting from current (0) */
+{
+  ASSERT (isPartial);
+
+  for (size_t j = 0; j < partialStart.size (); ++j)
+  {
+    if (position >= partialStart[j]
+        && position < partialEnd[j])
+    {
+      return partialValues[time_step_back][j]->get (position - partialStart[j]);
+    }
+  }
+
+  return NULLPTR;
+} /* Grid<TCoord>::getPartialFieldValue */
+
+/**
+ * Check whether value of point is stored in grid, i.e. grid is not partial or point is in one of its boxes
+ *
+ * @return true, if value of point is stored
+ */
+template <class TCoord>
+bool
+Grid<TCoord>::isStored (const TCoord &position) /**< coordinate in grid */
+{
+  ASSERT (isLegitIndex (position));
+
+  return !isPartial
+         || getPartialFieldValue (position, 0) != NULLPTR;
+} /* Grid<TCoord>::isStored */
+
+/**
+ * Get number of values, for which memory is allocated, in all time layers
+ *
+ * @return number of allocated values
+ */
+template <class TCoord>
+grid_coord
+Grid<TCoord>::getCountAllocatedValues () const
+{
+  if (!isPartial)
+  {
+    return size.calculateTotalCoord () * getCountAllocatedSteps ();
+  }
+
+  grid_coord count = 0;
+  for (size_t j = 0; j < partialStart.size (); ++j)
+  {
+    count += (partialEnd[j] - partialStart[j]).calculateTotalCoord ();
+  }
+
+  return count * getCountAllocatedSteps ();
+} /* Grid<TCoord>::getCountAllocatedValues */
+
 /**
  * Get field value at coordinate in grid
  *
@@ -1150,6 +1687,30 @@ Grid<TCoord>::getFieldValue (const TCoord &position, /**< coordinate in grid */
   ASSERT (isLegitIndex (position));
   ASSERT (time_step_back < gridValues.size ());
 
+  if (isCompact)
+  {
+    /*
+     * Values of compact grid should not be changed through the returned pointer
+     */
+    grid_coord index = VectorFieldValues<TCoord>::calculateIndex (position, size);
+    if (!compactIndexes8.empty ())
+    {
+      return &compactValues[compactIndexes8[index]];
+    }
+    if (!compactIndexes16.empty ())
+    {
+      return &compactValues[compactIndexes16[index]];
+    }
+    return &compactValues[0];
+  }
+
+  if (isPartial)
+  {
+    FieldValue *value = getPartialFieldValue (position, time_step_back);
+    ASSERT (value != NULLPTR);
+    return value;
+  }
+
   return gridValues[time_step_back]->get (position);
 } /* Grid<TCoord>::getFieldValue */
 
@@ -1176,6 +1737,11 @@ FieldValue *
 Grid<TCoord>::getFieldValueOrNullByAbsolutePos (const TCoord &relPosition, /**< relative coordinate in grid */
                                                 int time_step_back) /**< index of previous time step, starting from current (0) */
 {
+  if (!isStored (relPosition))
+  {
+    return NULLPTR;
+  }
+
   return getFieldValueByAbsolutePos (relPosition, time_step_back);
 } /* Grid<TCoord>::getFieldValueOrNullByAbsolutePos */
 
@@ -1270,6 +1836,17 @@ void
 Grid<TCoord>::initialize (const FieldValue & cur)
 {
   ASSERT (gridValues.size () > 0);
+  ASSERT (!isCompact);
+
+  if (isPartial)
+  {
+    for (size_t j = 0; j < partialValues[0].size (); ++j)
+    {
+      partialValues[0][j]->initialize (cur);
+    }
+    return;
+  }
+
   gridValues[0]->initialize (cur);
 } /* Grid<TCoord>::initialize */
 
@@ -1278,6 +1855,8 @@ VectorFieldValues<TCoord> *
 Grid<TCoord>::getRaw (int time_step_back)
 {
   ASSERT (time_step_back < gridValues.size ());
+  ASSERT (!isCompact);
+  ASSERT (!isPartial);
 
   return gridValues[time_step_back];
 }
@@ -1286,14 +1865,14 @@ template <class TCoord>
 typename VectorFieldValues<TCoord>::Iterator
 Grid<TCoord>::begin ()
 {
-  return getRaw (0)->begin ();
+  return typename VectorFieldValues<TCoord>::Iterator (size.getZero (), size.getZero (), size);
 }
 
 template <class TCoord>
 typename VectorFieldValues<TCoord>::Iterator
 Grid<TCoord>::end ()
 {
-  return getRaw (0)->end ();
+  return VectorFieldValues<TCoord>::Iterator::getEndIterator (size.getZero (), size);
 }
 
 /**
@@ -1308,6 +1887,23 @@ Grid<TCoord>::shiftInTime ()
    */
   ASSERT (gridValues.size () > 0);
 
+  if (isInPlace)
+  {
+    /*
+     * All time layers share the same values, which are already the current ones
+     */
+    return;
+  }
+
+  if (isPartial)
+  {
+    for (int i = partialValues.size () - 1; i >= 1; --i)
+    {
+      partialValues[i].swap (partialValues[i - 1]);
+    }
+    return;
+  }
+
   VectorFieldValues<TCoord> *oldest = gridValues[gridValues.size () - 1];
 
   for (int i = gridValues.size () - 1; i >= 1; --i)
@@ -1318,4 +1914,83 @@ Grid<TCoord>::shiftInTime ()
   gridValues[0] = oldest;
 } /* Grid<TCoord>::shiftInTime */
 
+/**
+ * Convert grid with single time layer to compact form, in which each point stores index of its value in table
+ * of distinct values of grid (one byte for up to 256 values, two bytes for up to GRID_COMPACT_MAX_VALUES values),
+ * and grid with a single value stores only this value. This is useful for grids of materials, which are usually
+ * piecewise constant.
+ *
+ * Compact grid is read-only: values could be only read by getFieldValue and similar functions.
+ *
+ * @return true, if grid was converted to compact form
+ */
+template <class TCoord>
+bool
+Grid<TCoord>::compact ()
+{
+  if (isCompact
+      || isPartial
+      || gridValues.size () != 1)
+  {
+    return false;
+  }
+
+  grid_coord count = size.calculateTotalCoord ();
+  const FieldValue *data = gridValues[0]->getRawData ();
+
+  std::map<FieldValue, uint16_t, FieldValueLess> valueIndexes;
+  std::vector<uint16_t> indexes (count);
+
+  for (grid_coord i = 0; i < count; ++i)
+  {
+    /*
+     * Neighbouring points usually have the same values
+     */
+    if (i > 0 && data[i] == data[i - 1])
+    {
+      indexes[i] = indexes[i - 1];
+      continue;
+    }
+
+    typename std::map<FieldValue, uint16_t, FieldValueLess>::iterator it = valueIndexes.find (data[i]);
+    if (it != valueIndexes.end ())
+    {
+      indexes[i] = it->second;
+      continue;
+    }
+
+    if (compactValues.size () == GRID_COMPACT_MAX_VALUES)
+    {
+      compactValues.clear ();
+      return false;
+    }
+
+    indexes[i] = (uint16_t) compactValues.size ();
+    valueIndexes[data[i]] = indexes[i];
+    compactValues.push_back (data[i]);
+  }
+
+  if (compactValues.size () > 256)
+  {
+    compactIndexes16.swap (indexes);
+  }
+  else if (compactValues.size () > 1)
+  {
+    compactIndexes8.resize (count);
+    for (grid_coord i = 0; i < count; ++i)
+    {
+      compactIndexes8[i] = (uint8_t) indexes[i];
+    }
+  }
+
+  delete gridValues[0];
+  gridValues[0] = NULLPTR;
+  isCompact = true;
+
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Grid '%s' is compact with " C_MOD " distinct values.\n",
+    gridName.data (), (grid_coord) compactValues.size ());
+
+  return true;
+} /* Grid<TCoord>::compact */
+
 #endif /* GRID_H */
@@ -66,6 +66,8 @@ ParallelGrid::ParallelGrid (const ParallelGridCoordinate &totSize, /**< total si
                             int timeOffset, /**< offset of time step in form t+timeOffset/2, at which grid should be shared */
                             const char * name) /**< name of grid */
   : ParallelGridBase (storedSteps, name)
+  , shareTimeLayerStart (0)
+  , shareTimeLayerEnd (storedSteps)
 {
   /*
    * These are required here to properly setup bufferSize, because ParallelGridGroup does not exist yet
@@ -285,54 +287,116 @@ ParallelGrid::SendReceiveRawBuffer (BufferPosition bufferSend, /**< buffer's pos
 } /* ParallelGrid::SendReceiveRawBuffer */
 
 /**
- * Send buffer in specified direction and receive buffer from the opposite direction
+ * Copy values in [start, end) box between raw storage of one time layer and contiguous buffer. Values are copied by
+ * whole contiguous rows of raw storage (last coordinate changes).
+ *
+ * @return number of values copied
  */
-void
-ParallelGrid::SendReceiveBuffer (BufferPosition bufferDirection) /**< buffer direction to send data to and receive data
-                                                                  *   from the opposite direction */
+static grid_coord
+copyBoxRows (VectorFieldValues<ParallelGridCoordinate> *values, /**< raw storage */
+             ParallelGridCoordinate start, /**< start coordinate of box */
+             ParallelGridCoordinate end, /**< end coordinate of box */
+             FieldValue *buffer, /**< buffer */
+             bool toBuffer) /**< flag whether to copy values from raw storage to buffer or vice versa */
 {
-  /*
-   * Return if node not used.
-   */
-#ifdef PARALLEL_BUFFER_DIMENSION_3D_XYZ
-  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXYZ ())
+  grid_coord rowLength = VectorFieldValues<ParallelGridCoordinate>::getRowLength (start, end);
+  if (rowLength <= 0)
   {
-    return;
+    return 0;
   }
-#endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_XY
-  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXY ())
+  ParallelGridCoordinate rowsEnd = VectorFieldValues<ParallelGridCoordinate>::getRowStartsEnd (start, end);
+  grid_coord rowCount = (rowsEnd - start).calculateTotalCoord ();
+  size_t rowBytes = rowLength * sizeof (FieldValue);
+
+  grid_coord index = 0;
+
+  for (grid_coord row = 0; row < rowCount; ++row)
   {
-    return;
+    ParallelGridCoordinate pos = VectorFieldValues<ParallelGridCoordinate>::getPosition (start, rowsEnd, row);
+
+    if (toBuffer)
+    {
+      memcpy (buffer + index, values->get (pos), rowBytes);
+    }
+    else
+    {
+      memcpy (values->get (pos), buffer + index, rowBytes);
+    }
+
+    index += rowLength;
   }
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_XY */
 
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_YZ
-  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeYZ ())
+  return index;
+} /* copyBoxRows */
+
+/**
+ * Copy values of shared time steps in [start, end) box between grid and contiguous buffer. Time layers are placed in
+ * buffer one after another.
+ *
+ * @return number of values copied
+ */
+grid_coord
+ParallelGrid::copyBox (ParallelGridCoordinate start, /**< start coordinate of box */
+                       ParallelGridCoordinate end, /**< end coordinate of box */
+                       FieldValue *buffer, /**< buffer */
+                       bool toBuffer) /**< flag whether to copy values from grid to buffer or vice versa */
+{
+  grid_coord index = 0;
+
+  for (int t = shareTimeLayerStart; t < shareTimeLayerEnd; ++t)
   {
-    return;
+    index += copyBoxRows (getRaw (t), start, end, buffer + index, toBuffer);
   }
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_YZ */
 
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_XZ
-  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXZ ())
+  return index;
+} /* ParallelGrid::copyBox */
+
+/**
+ * Copy values of shared time steps, which should be sent in specified direction, to send buffer
+ *
+ * @return number of values copied to send buffer
+ */
+grid_coord
+ParallelGrid::copyToSendBuffer (BufferPosition bufferDirection, /**< buffer direction to send data to */
+                                FieldValue *buffer) /**< out: send buffer */
+{
+  return copyBox (getSendStart (bufferDirection), getSendEnd (bufferDirection), buffer, true);
+} /* ParallelGrid::copyToSendBuffer */
+
+/**
+ * Copy values of shared time steps, which were received from the opposite to specified direction, from receive buffer
+ *
+ * @return number of values copied from receive buffer
+ */
+grid_coord
+ParallelGrid::copyFromReceiveBuffer (BufferPosition bufferDirection, /**< buffer direction, to which data was sent by
+                                                                      *   the neighbor */
+                                     const FieldValue *buffer) /**< receive buffer */
+{
+  return copyBox (getRecvStart (bufferDirection), getRecvEnd (bufferDirection), (FieldValue *) buffer, false);
+} /* ParallelGrid::copyFromReceiveBuffer */
+
+/**
+ * Send buffer in specified direction and receive buffer from the opposite direction
+ */
+void
+ParallelGrid::SendReceiveBuffer (BufferPosition bufferDirection) /**< buffer direction to send data to and receive data
+                                                                  *   from the opposite direction */
+{
+  /*
+   * Return if node not used.
+   */
+  if (!getGroupConst ()->isShareNode ())
   {
     return;
   }
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
 
   BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
 
   int processTo = parallelGridCore->getNodeForDirection (bufferDirection);
   int processFrom = parallelGridCore->getNodeForDirection (opposite);
 
-  ParallelGridCoordinate sendStart = getSendStart (bufferDirection);
-  ParallelGridCoordinate sendEnd = getSendEnd (bufferDirection);
-
-  ParallelGridCoordinate recvStart = getRecvStart (bufferDirection);
-  ParallelGridCoordinate recvEnd = getRecvEnd (bufferDirection);
-
   VectorBuffers &buffersSend = getGroup ()->getBuffersSend ();
   VectorBuffers &buffersReceive = getGroup ()->getBuffersReceive ();
 
@@ -341,38 +405,7 @@ ParallelGrid::SendReceiveBuffer (BufferPosition bufferDirection) /**< buffer dir
    */
   if (processTo != PID_NONE)
   {
-    grid_coord index = 0;
-
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    for (grid_coord i = sendStart.get1 (); i < sendEnd.get1 (); ++i)
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-    {
-#if defined (GRID_2D) || defined (GRID_3D)
-      for (grid_coord j = sendStart.get2 (); j < sendEnd.get2 (); ++j)
-#endif /* GRID_2D || GRID_3D */
-      {
-#if defined (GRID_3D)
-        for (grid_coord k = sendStart.get3 (); k < sendEnd.get3 (); ++k)
-#endif /* GRID_3D */
-        {
-
-#if defined (GRID_1D)
-          ParallelGridCoordinate pos (i COORD_TYPES);
-#endif /* GRID_1D */
-#if defined (GRID_2D)
-          ParallelGridCoordinate pos (i, j COORD_TYPES);
-#endif /* GRID_2D */
-#if defined (GRID_3D)
-          ParallelGridCoordinate pos (i, j, k COORD_TYPES);
-#endif /* GRID_3D */
-
-          for (int t = 0; t < gridValues.size (); ++t)
-          {
-            buffersSend[bufferDirection][index++] = *getFieldValue (pos, t);
-          }
-        }
-      }
-    }
+    copyToSendBuffer (bufferDirection, buffersSend[bufferDirection].data ());
   }
 
   DPRINTF (LOG_LEVEL_FULL, "\tSHARE RAW. PID=#%d. Directions TO(%s=#%d), FROM(%s=#%d).\n",
@@ -475,38 +508,7 @@ ParallelGrid::SendReceiveBuffer (BufferPosition bufferDirection) /**< buffer dir
    */
   if (processFrom != PID_NONE)
   {
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    for (grid_coord index = 0, i = recvStart.get1 (); i < recvEnd.get1 (); ++i)
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-    {
-
-#if defined (GRID_2D) || defined (GRID_3D)
-      for (grid_coord j = recvStart.get2 (); j < recvEnd.get2 (); ++j)
-#endif /* GRID_2D || GRID_3D */
-      {
-
-#if defined (GRID_3D)
-        for (grid_coord k = recvStart.get3 (); k < recvEnd.get3 (); ++k)
-#endif /* GRID_3D */
-        {
-
-#if defined (GRID_1D)
-          ParallelGridCoordinate pos (i COORD_TYPES);
-#endif /* GRID_1D */
-#if defined (GRID_2D)
-          ParallelGridCoordinate pos (i, j COORD_TYPES);
-#endif /* GRID_2D */
-#if defined (GRID_3D)
-          ParallelGridCoordinate pos (i, j, k COORD_TYPES);
-#endif /* GRID_3D */
-
-          for (int t = 0; t < gridValues.size (); ++t)
-          {
-            setFieldValue (buffersReceive[opposite][index++], pos, t);
-          }
-        }
-      }
-    }
+    copyFromReceiveBuffer (bufferDirection, buffersReceive[opposite].data ());
   }
 } /* ParallelGrid::SendReceiveBuffer */
 
@@ -543,204 +545,200 @@ ParallelGrid::SendReceive ()
 void
 ParallelGrid::share ()
 {
+#ifdef DYNAMIC_GRID
+  /*
+   * Dynamic grid measures time of each share operation, so share operations are performed separately for each direction
+   */
   SendReceive ();
   MPI_Barrier (ParallelGrid::getParallelCore ()->getCommunicator ());
+#else /* DYNAMIC_GRID */
+  std::vector<ParallelGrid *> grids (1, this);
+
+  getGroup ()->startShare (grids);
+  getGroup ()->finishShare ();
+#endif /* !DYNAMIC_GRID */
 } /* ParallelGrid::share */
 
 /**
- * Allocate and gather full grid from all nodes to one non-parallel grid on each node
+ * Allocate and gather full grid from all nodes to one non-parallel grid on root node (process 0) or on each node
  *
- * @return full grid from all nodes as one non-parallel grid on each node
+ * @return full grid from all nodes as one non-parallel grid (NULLPTR on non-root nodes, if isGatherToAll is false)
  *
  * Note: caller has to delete returned grid!
  */
 ParallelGridBase *
-ParallelGrid::gatherFullGrid () const
+ParallelGrid::gatherFullGrid (bool isGatherToAll) const /**< flag whether to gather full grid on each node */
 {
-  ParallelGridBase *grid = new ParallelGridBase (getTotalSize (), gridValues.size (), getName ());
+  ParallelGridBase *grid = NULLPTR;
+
+  if (isGatherToAll || ParallelGrid::getParallelCore ()->getProcessId () == 0)
+  {
+    grid = new ParallelGridBase (getTotalSize (), gridValues.size (), getName ());
+  }
 
-  return gatherFullGridPlacement (grid);
+  return gatherFullGridPlacement (grid, isGatherToAll);
 } /* ParallelGrid::gatherFullGrid */
 
 /**
- * Gather full grid from all nodes to one non-parallel grid on each node
+ * Gather full grid from all nodes to one non-parallel grid on root node (process 0) or on each node. Start positions
+ * and sizes of chunks of all nodes are gathered first, then values of all time layers of chunks are gathered with a
+ * single collective operation.
  *
- * @return full grid from all nodes as one non-parallel grid on each node
+ * Placement grid is not used on non-root nodes, if isGatherToAll is false, and might be NULLPTR there.
  *
- * Note: caller has to delete returned grid!
+ * @return full grid from all nodes as one non-parallel grid (placement grid)
  */
 ParallelGridBase *
-ParallelGrid::gatherFullGridPlacement (ParallelGridBase *placementGrid) const
+ParallelGrid::gatherFullGridPlacement (ParallelGridBase *placementGrid, /**< grid to gather values to */
+                                       bool isGatherToAll) const /**< flag whether to gather full grid on each node */
 {
   ParallelGridBase *grid = placementGrid;
 
-  std::vector<FieldValue> values (getTotalSize ().calculateTotalCoord ());
+  ParallelGridCore *core = ParallelGrid::getParallelCore ();
+  int processCount = core->getTotalProcCount ();
+  bool isReceiver = isGatherToAll || core->getProcessId () == 0;
+
+  ASSERT (!isReceiver || (grid != NULLPTR && grid->getCountStoredSteps () == gridValues.size ()));
+
+  ParallelGridCoordinate chunkStart = getGroupConst ()->getChunkStartPosition ();
+  ParallelGridCoordinate chunkSize = getGroupConst ()->getCurrentSize ();
 
   /*
-   * Each computational node broadcasts to all others its data
+   * Start position and size of chunk of each node
    */
+  const int chunkInfoSize = 6;
+  grid_coord chunkInfo[chunkInfoSize] = { 0, 0, 0, 0, 0, 0 };
 
-  for (int process = 0; process < ParallelGrid::getParallelCore ()->getTotalProcCount (); ++process)
-  {
-    ParallelGridCoordinate chunkStart = getGroupConst ()->getChunkStartPosition ();
-    ParallelGridCoordinate chunkEnd = chunkStart + getGroupConst ()->getCurrentSize ();
-
-    /*
-     * Send start coord, end coord
-     */
 #if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    grid_coord startX;
-    grid_coord endX;
-
-    if (process == ParallelGrid::getParallelCore ()->getProcessId ())
-    {
-      startX = chunkStart.get1 ();
-      endX = chunkEnd.get1 ();
-    }
-
-    MPI_Bcast (&startX, 1, MPI_COORD, process, ParallelGrid::getParallelCore ()->getCommunicator ());
-    MPI_Bcast (&endX, 1, MPI_COORD, process, ParallelGrid::getParallelCore ()->getCommunicator ());
+  chunkInfo[0] = chunkStart.get1 ();
+  chunkInfo[3] = chunkSize.get1 ();
 #endif /* GRID_1D || GRID_2D || GRID_3D */
-
 #if defined (GRID_2D) || defined (GRID_3D)
-    grid_coord startY;
-    grid_coord endY;
-
-    if (process == ParallelGrid::getParallelCore ()->getProcessId ())
-    {
-      startY = chunkStart.get2 ();
-      endY = chunkEnd.get2 ();
-    }
-
-    MPI_Bcast (&startY, 1, MPI_COORD, process, ParallelGrid::getParallelCore ()->getCommunicator ());
-    MPI_Bcast (&endY, 1, MPI_COORD, process, ParallelGrid::getParallelCore ()->getCommunicator ());
+  chunkInfo[1] = chunkStart.get2 ();
+  chunkInfo[4] = chunkSize.get2 ();
 #endif /* GRID_2D || GRID_3D */
-
 #if defined (GRID_3D)
-    grid_coord startZ;
-    grid_coord endZ;
+  chunkInfo[2] = chunkStart.get3 ();
+  chunkInfo[5] = chunkSize.get3 ();
+#endif /* GRID_3D */
 
-    if (process == ParallelGrid::getParallelCore ()->getProcessId ())
-    {
-      startZ = chunkStart.get3 ();
-      endZ = chunkEnd.get3 ();
-    }
+  std::vector<grid_coord> chunkInfos (isReceiver ? processCount * chunkInfoSize : 0);
 
-    MPI_Bcast (&startZ, 1, MPI_COORD, process, ParallelGrid::getParallelCore ()->getCommunicator ());
-    MPI_Bcast (&endZ, 1, MPI_COORD, process, ParallelGrid::getParallelCore ()->getCommunicator ());
-#endif /* GRID_3D */
+  int retCode;
+  if (isGatherToAll)
+  {
+    retCode = MPI_Allgather (chunkInfo, chunkInfoSize, MPI_COORD,
+                             chunkInfos.data (), chunkInfoSize, MPI_COORD,
+                             core->getCommunicator ());
+  }
+  else
+  {
+    retCode = MPI_Gather (chunkInfo, chunkInfoSize, MPI_COORD,
+                          chunkInfos.data (), chunkInfoSize, MPI_COORD,
+                          0, core->getCommunicator ());
+  }
+  ASSERT (retCode == MPI_SUCCESS);
+
+  /*
+   * Copy values of chunk of current node (without buffers) to send buffer
+   */
+  grid_coord left_coord, right_coord;
+  grid_coord down_coord, up_coord;
+  grid_coord back_coord, front_coord;
+
+  getGroupConst ()->initBufferOffsets (left_coord, right_coord, down_coord, up_coord, back_coord, front_coord);
 
 #ifdef GRID_1D
-    ParallelGridCoordinate sizeCoord (endX - startX COORD_TYPES);
+  ParallelGridCoordinate localStart (left_coord COORD_TYPES);
 #endif /* GRID_1D */
 #ifdef GRID_2D
-    ParallelGridCoordinate sizeCoord (endX - startX, endY - startY COORD_TYPES);
+  ParallelGridCoordinate localStart (left_coord, down_coord COORD_TYPES);
 #endif /* GRID_2D */
 #ifdef GRID_3D
-    ParallelGridCoordinate sizeCoord (endX - startX, endY - startY, endZ - startZ COORD_TYPES);
+  ParallelGridCoordinate localStart (left_coord, down_coord, back_coord COORD_TYPES);
 #endif /* GRID_3D */
 
-    /*
-     * Fill vectors with data for current computational node
-     */
+  grid_coord chunkCount = chunkSize.calculateTotalCoord ();
 
-    for (int t = 0; t < gridValues.size (); ++t)
-    {
-      if (process == ParallelGrid::getParallelCore ()->getProcessId ())
-      {
-        grid_coord left_coord, right_coord;
-        grid_coord down_coord, up_coord;
-        grid_coord back_coord, front_coord;
+  std::vector<FieldValue> valuesSend (chunkCount * gridValues.size ());
+
+  grid_coord index = 0;
+  for (int t = 0; t < gridValues.size (); ++t)
+  {
+    index += copyBoxRows (gridValues[t], localStart, localStart + chunkSize, valuesSend.data () + index, true);
+  }
+  ASSERT (index == valuesSend.size ());
 
-        getGroupConst ()->initBufferOffsets (left_coord, right_coord, down_coord, up_coord, back_coord, front_coord);
+  /*
+   * Gather values of all nodes
+   */
+  std::vector<int> counts (isReceiver ? processCount : 0);
+  std::vector<int> displs (isReceiver ? processCount : 0);
 
-        grid_coord index = 0;
+  grid_coord totalCount = 0;
+  for (int process = 0; isReceiver && process < processCount; ++process)
+  {
+    grid_coord *info = chunkInfos.data () + process * chunkInfoSize;
 
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-        for (grid_coord i = left_coord; i < left_coord + sizeCoord.get1 (); ++i)
-        {
-#endif /* GRID_1D || GRID_2D || GRID_3D */
+    counts[process] = info[3] * gridValues.size ();
 #if defined (GRID_2D) || defined (GRID_3D)
-          for (grid_coord j = down_coord; j < down_coord + sizeCoord.get2 (); ++j)
-          {
+    counts[process] *= info[4];
 #endif /* GRID_2D || GRID_3D */
 #if defined (GRID_3D)
-            for (grid_coord k = back_coord; k < back_coord + sizeCoord.get3 (); ++k)
-            {
-#endif /* GRID_3D */
-
-#ifdef GRID_1D
-              ParallelGridCoordinate pos (i COORD_TYPES);
-#endif /* GRID_1D */
-#ifdef GRID_2D
-              ParallelGridCoordinate pos (i, j COORD_TYPES);
-#endif /* GRID_2D */
-#ifdef GRID_3D
-              ParallelGridCoordinate pos (i, j, k COORD_TYPES);
-#endif /* GRID_3D */
-
-              values[index] = *gridValues[t]->get (pos);
-
-              ++index;
-
-#if defined (GRID_3D)
-            }
+    counts[process] *= info[5];
 #endif /* GRID_3D */
-#if defined (GRID_2D) || defined (GRID_3D)
-          }
-#endif /* GRID_2D || GRID_3D */
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-        }
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-
-        ASSERT (index == sizeCoord.calculateTotalCoord ());
-      }
 
-      /*
-       * Broadcast data
-       */
+    displs[process] = totalCount;
+    totalCount += counts[process];
+  }
 
-      MPI_Bcast (values.data (), sizeCoord.calculateTotalCoord (), MPI_FPVALUE, process, ParallelGrid::getParallelCore ()->getCommunicator ());
+  std::vector<FieldValue> valuesReceive (totalCount);
 
-      grid_coord index = 0;
+  if (isGatherToAll)
+  {
+    retCode = MPI_Allgatherv (valuesSend.data (), valuesSend.size (), MPI_FPVALUE,
+                              valuesReceive.data (), counts.data (), displs.data (), MPI_FPVALUE,
+                              core->getCommunicator ());
+  }
+  else
+  {
+    retCode = MPI_Gatherv (valuesSend.data (), valuesSend.size (), MPI_FPVALUE,
+                           valuesReceive.data (), counts.data (), displs.data (), MPI_FPVALUE,
+                           0, core->getCommunicator ());
+  }
+  ASSERT (retCode == MPI_SUCCESS);
 
-      /*
-       * Store data to corresponding coordinates of the resulting grid
-       */
+  if (!isReceiver)
+  {
+    return grid;
+  }
 
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-      for (grid_coord i = startX; i < endX; ++i)
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-      {
-#if defined (GRID_2D) || defined (GRID_3D)
-        for (grid_coord j = startY; j < endY; ++j)
-#endif /* GRID_2D || GRID_3D */
-        {
-#if defined (GRID_3D)
-          for (grid_coord k = startZ; k < endZ; ++k)
-#endif /* GRID_3D */
-          {
+  /*
+   * Store data to corresponding coordinates of the resulting grid
+   */
+  for (int process = 0; process < processCount; ++process)
+  {
+    grid_coord *info = chunkInfos.data () + process * chunkInfoSize;
 
 #ifdef GRID_1D
-            ParallelGridCoordinate pos (i COORD_TYPES);
+    ParallelGridCoordinate start (info[0] COORD_TYPES);
+    ParallelGridCoordinate end (info[0] + info[3] COORD_TYPES);
 #endif /* GRID_1D */
 #ifdef GRID_2D
-            ParallelGridCoordinate pos (i, j COORD_TYPES);
+    ParallelGridCoordinate start (info[0], info[1] COORD_TYPES);
+    ParallelGridCoordinate end (info[0] + info[3], info[1] + info[4] COORD_TYPES);
 #endif /* GRID_2D */
 #ifdef GRID_3D
-            ParallelGridCoordinate pos (i, j, k COORD_TYPES);
+    ParallelGridCoordinate start (info[0], info[1], info[2] COORD_TYPES);
+    ParallelGridCoordinate end (info[0] + info[3], info[1] + info[4], info[2] + info[5] COORD_TYPES);
 #endif /* GRID_3D */
 
-            grid->setFieldValue (values[index], pos, t);
-
-            ++index;
-          }
-        }
-      }
-      ASSERT (index == sizeCoord.calculateTotalCoord ());
-
-      MPI_Barrier (ParallelGrid::getParallelCore ()->getCommunicator ());
+    index = displs[process];
+    for (int t = 0; t < gridValues.size (); ++t)
+    {
+      index += copyBoxRows (grid->getRaw (t), start, end, valuesReceive.data () + index, false);
     }
+    ASSERT (index == displs[process] + counts[process]);
   }
 
   return grid;
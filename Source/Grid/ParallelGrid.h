@@ -242,6 +242,16 @@ private:
    */
   int groupId;
 
+  /**
+   * First time layer, values of which are sent by share operations
+   */
+  int shareTimeLayerStart;
+
+  /**
+   * Time layer, until which values are sent by share operations
+   */
+  int shareTimeLayerEnd;
+
 private:
 
   void SendRawBuffer (BufferPosition, int);
@@ -250,6 +260,8 @@ private:
   void SendReceiveBuffer (BufferPosition);
   void SendReceive ();
 
+  grid_coord copyBox (ParallelGridCoordinate, ParallelGridCoordinate, FieldValue *, bool);
+
 public:
 
   ParallelGrid (const ParallelGridCoordinate &,
@@ -284,6 +296,32 @@ public:
 
   void share ();
 
+  /**
+   * Set range of time layers, values of which are sent by share operations. By default all time layers are sent,
+   * however, usually only some of them are read from buffers.
+   */
+  void setShareTimeLayers (int start, /**< first time layer to send */
+                           int end) /**< time layer until which to send */
+  {
+    ASSERT (start >= 0 && start < end && end <= gridValues.size ());
+
+    shareTimeLayerStart = start;
+    shareTimeLayerEnd = end;
+  } /* setShareTimeLayers */
+
+  /**
+   * Getter for number of time layers, values of which are sent by share operations
+   *
+   * @return number of time layers, values of which are sent by share operations
+   */
+  int getShareTimeLayersCount () const
+  {
+    return shareTimeLayerEnd - shareTimeLayerStart;
+  } /* getShareTimeLayersCount */
+
+  grid_coord copyToSendBuffer (BufferPosition, FieldValue *);
+  grid_coord copyFromReceiveBuffer (BufferPosition, const FieldValue *);
+
   /**
    * Get share step
    *
@@ -447,8 +485,8 @@ public:
     return getGroupConst ()->getTotalSize ();
   } /* getTotalSize */
 
-  ParallelGridBase *gatherFullGrid () const;
-  ParallelGridBase *gatherFullGridPlacement (ParallelGridBase *) const;
+  ParallelGridBase *gatherFullGrid (bool) const;
+  ParallelGridBase *gatherFullGridPlacement (ParallelGridBase *, bool) const;
 
 #ifdef DYNAMIC_GRID
   void Resize (ParallelGridCoordinate);
@@ -50,7 +50,7 @@ ParallelGrid::Resize (ParallelGridCoordinate newCurrentNodeSize) /**< new size o
   /*
    * TODO: do not allocate each time
    */
-  ParallelGridBase *totalGrid = gatherFullGrid ();
+  ParallelGridBase *totalGrid = gatherFullGrid (true);
 
   ParallelGridCoordinate oldSize = currentSize;
 
@@ -19,6 +19,7 @@
  */
 
 #include "ParallelGridGroup.h"
+#include "ParallelGrid.h"
 
 #ifdef PARALLEL_GRID
 
@@ -136,6 +137,56 @@ ParallelGridGroup::ParallelGridGroupConstructor ()
           currentSize.get3 ());
 } /* ParallelGridGroup::ParallelGridGroupConstructor */
 
+/**
+ * Get start position of chunk of current node by one axis. It is the sum of sizes of chunks of all enabled nodes, which
+ * precede current node by this axis and have the same position by other axes in the nodes' grid. The sum is computed
+ * by exclusive scan over such nodes.
+ *
+ * @return start position of chunk by axis
+ */
+grid_coord
+ParallelGridGroup::scanStartPosition (int nodeGridCoord, /**< coordinate of current node in the nodes' grid by axis */
+                                      int nodeGridStride, /**< difference of ids of nodes, which are neighbors by
+                                                           *   axis */
+                                      grid_coord chunkSize, /**< size of chunk of current node by axis */
+                                      bool isEnabled) /**< flag whether current node participates in computations */
+{
+  /*
+   * Nodes, which have the same position by other axes, have the same id of the first node by axis
+   */
+  int color = isEnabled ? getParallelCore ()->getProcessId () - nodeGridCoord * nodeGridStride : MPI_UNDEFINED;
+
+  MPI_Comm comm;
+  int retCode = MPI_Comm_split (getParallelCore ()->getCommunicator (), color, nodeGridCoord, &comm);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  if (!isEnabled)
+  {
+    return 0;
+  }
+
+  grid_coord start = 0;
+  retCode = MPI_Exscan (&chunkSize, &start, 1, MPI_COORD, MPI_SUM, comm);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  int rank;
+  retCode = MPI_Comm_rank (comm, &rank);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  /*
+   * Result of exclusive scan is undefined for the first node
+   */
+  if (rank == 0)
+  {
+    start = 0;
+  }
+
+  retCode = MPI_Comm_free (&comm);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  return start;
+} /* ParallelGridGroup::scanStartPosition */
+
 /**
  * Gather start position for all computational nodes
  */
@@ -147,196 +198,103 @@ void ParallelGridGroup::gatherStartPosition ()
            parallelGridCore->getProcessId (),
            parallelGridCore->getTotalProcCount ());
 
+  int state = 1;
+#ifdef DYNAMIC_GRID
+  state = getParallelCore ()->getNodeState ()[getParallelCore ()->getProcessId ()];
+#endif /* DYNAMIC_GRID */
+
+  /*
+   * Nodes, which do not participate in computations, do not affect start positions of other nodes
+   */
+  bool isEnabled = state && isShareNode ();
+
 #if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
   grid_coord startx = 0;
-  grid_coord endx = 0;
 #endif /* GRID_1D || GRID_2D || GRID_3D */
 #if defined (GRID_2D) || defined (GRID_3D)
   grid_coord starty = 0;
-  grid_coord endy = 0;
 #endif /* GRID_2D || GRID_3D */
 #ifdef GRID_3D
   grid_coord startz = 0;
-  grid_coord endz = 0;
 #endif /* GRID_3D */
 
-  for (int process = 0; process < getParallelCore ()->getTotalProcCount (); ++process)
-  {
-    /*
-     * Receive start position from previous nodes
-     */
-
-    bool hasReceivedX = false;
-    bool hasReceivedY = false;
-    bool hasReceivedZ = false;
-
-    MPI_Status status;
-    int retCode;
-
-    int state = 1;
-#ifdef DYNAMIC_GRID
-    state = getParallelCore ()->getNodeState ()[getParallelCore ()->getProcessId ()];
-#endif /* DYNAMIC_GRID */
-
+  /*
+   * Id of node is linear in its coordinates in the nodes' grid, with stride of each axis being the product of sizes
+   * of the nodes' grid by previous parallelized axes
+   */
 #if defined (PARALLEL_BUFFER_DIMENSION_1D_X) || defined (PARALLEL_BUFFER_DIMENSION_2D_XY) || \
   defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
-
-    if (process == getParallelCore ()->getProcessId ()
-        && state
-        && getParallelCore ()->getNodeForDirection (LEFT) != PID_NONE)
-    {
-      retCode = MPI_Recv (&startx,
-                          1,
-                          MPI_COORD,
-                          getParallelCore ()->getNodeForDirection (LEFT),
-                          0,
-                          getParallelCore ()->getCommunicator (),
-                          &status);
-      ASSERT (retCode == MPI_SUCCESS);
-
-      hasReceivedX = true;
-    }
-    else if (state
-             && getParallelCore ()->getNodeForDirection (RIGHT) == process)
-    {
-      retCode = MPI_Send (&endx,
-                          1,
-                          MPI_COORD,
-                          getParallelCore ()->getNodeForDirection (RIGHT),
-                          0,
-                          getParallelCore ()->getCommunicator ());
-      ASSERT (retCode == MPI_SUCCESS);
-    }
+  startx = scanStartPosition (isEnabled ? getParallelCore ()->getNodeGridX () : 0, 1, currentSize.get1 (), isEnabled);
 #endif /* PARALLEL_BUFFER_DIMENSION_1D_X || PARALLEL_BUFFER_DIMENSION_2D_XY ||
           PARALLEL_BUFFER_DIMENSION_2D_XZ || PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
 #if defined (PARALLEL_BUFFER_DIMENSION_1D_Y) || defined (PARALLEL_BUFFER_DIMENSION_2D_XY) || \
   defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
-
-    if (process == getParallelCore ()->getProcessId ()
-        && state
-        && getParallelCore ()->getNodeForDirection (DOWN) != PID_NONE)
-    {
-      retCode = MPI_Recv (&starty,
-                          1,
-                          MPI_COORD,
-                          getParallelCore ()->getNodeForDirection (DOWN),
-                          1,
-                          getParallelCore ()->getCommunicator (),
-                          &status);
-      ASSERT (retCode == MPI_SUCCESS);
-
-      hasReceivedY = true;
-    }
-    else if (state
-             && getParallelCore ()->getNodeForDirection (UP) == process)
-    {
-      retCode = MPI_Send (&endy,
-                          1,
-                          MPI_COORD,
-                          getParallelCore ()->getNodeForDirection (UP),
-                          1,
-                          getParallelCore ()->getCommunicator ());
-      ASSERT (retCode == MPI_SUCCESS);
-    }
+#if defined (PARALLEL_BUFFER_DIMENSION_2D_XY) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
+  int strideY = getParallelCore ()->getNodeGridSizeX ();
+#else /* PARALLEL_BUFFER_DIMENSION_2D_XY || PARALLEL_BUFFER_DIMENSION_3D_XYZ */
+  int strideY = 1;
+#endif /* !PARALLEL_BUFFER_DIMENSION_2D_XY && !PARALLEL_BUFFER_DIMENSION_3D_XYZ */
+  starty = scanStartPosition (isEnabled ? getParallelCore ()->getNodeGridY () : 0, strideY, currentSize.get2 (), isEnabled);
 #endif /* PARALLEL_BUFFER_DIMENSION_1D_Y || PARALLEL_BUFFER_DIMENSION_2D_XY ||
           PARALLEL_BUFFER_DIMENSION_2D_YZ || PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
 #if defined (PARALLEL_BUFFER_DIMENSION_1D_Z) || defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) || \
   defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
-
-    if (process == getParallelCore ()->getProcessId ()
-        && state
-        && getParallelCore ()->getNodeForDirection (BACK) != PID_NONE)
-    {
-      retCode = MPI_Recv (&startz,
-                          1,
-                          MPI_COORD,
-                          getParallelCore ()->getNodeForDirection (BACK),
-                          2,
-                          getParallelCore ()->getCommunicator (),
-                          &status);
-      ASSERT (retCode == MPI_SUCCESS);
-
-      hasReceivedZ = true;
-    }
-    else if (state
-             && getParallelCore ()->getNodeForDirection (FRONT) == process)
-    {
-      retCode = MPI_Send (&endz,
-                          1,
-                          MPI_COORD,
-                          getParallelCore ()->getNodeForDirection (FRONT),
-                          2,
-                          getParallelCore ()->getCommunicator ());
-      ASSERT (retCode == MPI_SUCCESS);
-    }
+#if defined (PARALLEL_BUFFER_DIMENSION_2D_YZ)
+  int strideZ = getParallelCore ()->getNodeGridSizeY ();
+#elif defined (PARALLEL_BUFFER_DIMENSION_2D_XZ)
+  int strideZ = getParallelCore ()->getNodeGridSizeX ();
+#elif defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
+  int strideZ = getParallelCore ()->getNodeGridSizeXY ();
+#else
+  int strideZ = 1;
+#endif
+  startz = scanStartPosition (isEnabled ? getParallelCore ()->getNodeGridZ () : 0, strideZ, currentSize.get3 (), isEnabled);
 #endif /* PARALLEL_BUFFER_DIMENSION_1D_Z || PARALLEL_BUFFER_DIMENSION_2D_YZ ||
           PARALLEL_BUFFER_DIMENSION_2D_XZ || PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
-    if (process == getParallelCore ()->getProcessId ()
-        && state)
-    {
-#ifndef DYNAMIC_GRID
-      // For dynamic grid only one node can be left, so nothing is received
-      // TODO: add check that a single node is left for dynamic grid
-      ASSERT (hasReceivedX || hasReceivedY || hasReceivedZ || process == 0);
-#endif /* !DYNAMIC_GRID */
-
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-      endx = startx + currentSize.get1 ();
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-#if defined (GRID_2D) || defined (GRID_3D)
-      endy = starty + currentSize.get2 ();
-#endif /* GRID_2D || GRID_3D */
-#if defined (GRID_3D)
-      endz = startz + currentSize.get3 ();
-#endif /* GRID_3D */
+  if (!state)
+  {
+    return;
+  }
 
 #ifdef GRID_1D
-      ParallelGridCoordinate startPosition = GridCoordinate1D (startx COORD_TYPES);
+  ParallelGridCoordinate startPosition = GridCoordinate1D (startx COORD_TYPES);
 #endif /* GRID_1D */
 #ifdef GRID_2D
-      ParallelGridCoordinate startPosition = GridCoordinate2D (startx, starty COORD_TYPES);
+  ParallelGridCoordinate startPosition = GridCoordinate2D (startx, starty COORD_TYPES);
 #endif /* GRID_2D */
 #ifdef GRID_3D
-      ParallelGridCoordinate startPosition = GridCoordinate3D (startx, starty, startz COORD_TYPES);
+  ParallelGridCoordinate startPosition = GridCoordinate3D (startx, starty, startz COORD_TYPES);
 #endif /* GRID_3D */
 
-      initializeStartPosition (startPosition);
-    }
+  initializeStartPosition (startPosition);
 
-    if (process == getParallelCore ()->getProcessId ()
-        && state)
-    {
 #ifdef GRID_1D
-      DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Start pos (" C_MOD ") for grid '%s' for proc %d (of %d)\n",
-               startx,
-               groupName.data (),
-               parallelGridCore->getProcessId (),
-               parallelGridCore->getTotalProcCount ());
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Start pos (" C_MOD ") for grid '%s' for proc %d (of %d)\n",
+           startx,
+           groupName.data (),
+           parallelGridCore->getProcessId (),
+           parallelGridCore->getTotalProcCount ());
 #endif /* GRID_1D */
 #ifdef GRID_2D
-      DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Start pos (" C_MOD ", " C_MOD ") for grid '%s' for proc %d (of %d)\n",
-               startx,
-               starty,
-               groupName.data (),
-               parallelGridCore->getProcessId (),
-               parallelGridCore->getTotalProcCount ());
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Start pos (" C_MOD ", " C_MOD ") for grid '%s' for proc %d (of %d)\n",
+           startx,
+           starty,
+           groupName.data (),
+           parallelGridCore->getProcessId (),
+           parallelGridCore->getTotalProcCount ());
 #endif /* GRID_2D */
 #ifdef GRID_3D
-      DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Start pos (" C_MOD ", " C_MOD ", " C_MOD ") for grid '%s' for proc %d (of %d)\n",
-               startx,
-               starty,
-               startz,
-               groupName.data (),
-               parallelGridCore->getProcessId (),
-               parallelGridCore->getTotalProcCount ());
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Start pos (" C_MOD ", " C_MOD ", " C_MOD ") for grid '%s' for proc %d (of %d)\n",
+           startx,
+           starty,
+           startz,
+           groupName.data (),
+           parallelGridCore->getProcessId (),
+           parallelGridCore->getTotalProcCount ());
 #endif /* GRID_3D */
-    }
-
-    MPI_Barrier (getParallelCore ()->getCommunicator ());
-  }
 } /* ParallelGridGroup::gatherStartPosition */
 
 
@@ -700,6 +658,193 @@ ParallelGridGroup::InitBuffers ()
 #endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 } /* ParallelGridGroup::InitBuffers */
 
+/**
+ * Check whether current node participates in share operations
+ *
+ * @return true, if current node participates in share operations, false otherwise
+ */
+bool
+ParallelGridGroup::isShareNode () const
+{
+#ifdef PARALLEL_BUFFER_DIMENSION_3D_XYZ
+  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXYZ ())
+  {
+    return false;
+  }
+#endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_XY
+  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXY ())
+  {
+    return false;
+  }
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_XY */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_YZ
+  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeYZ ())
+  {
+    return false;
+  }
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_YZ */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_XZ
+  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXZ ())
+  {
+    return false;
+  }
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
+
+  return true;
+} /* ParallelGridGroup::isShareNode */
+
+/**
+ * Get number of values, which are sent in specified direction by one share operation for specified grids. Only time
+ * layers, which are set to be shared for each grid, are sent.
+ *
+ * @return number of values to send
+ */
+grid_coord
+ParallelGridGroup::getShareCount (BufferPosition bufferDirection, /**< buffer direction to send data to */
+                                  const std::vector<ParallelGrid *> &grids) const /**< grids of this group to share */
+{
+  grid_coord pointsCount = buffersSend[bufferDirection].size () / storedSteps;
+
+  grid_coord count = 0;
+  for (size_t i = 0; i < grids.size (); ++i)
+  {
+    count += pointsCount * grids[i]->getShareTimeLayersCount ();
+  }
+
+  return count;
+} /* ParallelGridGroup::getShareCount */
+
+/**
+ * Start non-blocking share operations for all specified grids of this group at once: values from send regions of all
+ * grids are copied to one send buffer per direction and only one send and one receive is posted for each neighbor.
+ * Values in buffers of grids are updated only in finishShare, so computations, which do not read values from buffers,
+ * could be performed between startShare and finishShare.
+ *
+ * NOTE: dynamic grid measures time of each share operation, so share operations are performed in blocking mode
+ *       separately for each grid in this case (finishShare does nothing then).
+ */
+void
+ParallelGridGroup::startShare (const std::vector<ParallelGrid *> &grids) /**< grids of this group to share */
+{
+#ifdef DYNAMIC_GRID
+  for (size_t i = 0; i < grids.size (); ++i)
+  {
+    grids[i]->share ();
+  }
+#else /* DYNAMIC_GRID */
+  ASSERT (shareGrids.empty () && shareRequests.empty ());
+
+  if (!isShareNode ()
+      || grids.empty ())
+  {
+    return;
+  }
+
+  DPRINTF (LOG_LEVEL_FULL, "Start share of group '%s' PID=%d\n", groupName.c_str (), parallelGridCore->getProcessId ());
+
+  shareGrids = grids;
+
+  shareBuffersSend.resize (BUFFER_COUNT);
+  shareBuffersReceive.resize (BUFFER_COUNT);
+
+  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+  {
+    BufferPosition bufferDirection = (BufferPosition) buf;
+    BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
+
+    int processNeighbor = parallelGridCore->getNodeForDirection (bufferDirection);
+    if (processNeighbor == PID_NONE)
+    {
+      continue;
+    }
+
+    grid_coord count = getShareCount (bufferDirection, grids);
+    if (shareBuffersSend[bufferDirection].size () < count)
+    {
+      shareBuffersSend[bufferDirection].resize (count);
+      shareBuffersReceive[bufferDirection].resize (count);
+    }
+
+    /*
+     * Direction, to which data is sent, is used as tag. Neighbor sends values for this direction to the opposite one.
+     */
+    MPI_Request request;
+    int retCode = MPI_Irecv (shareBuffersReceive[bufferDirection].data (),
+                             count,
+                             MPI_FPVALUE,
+                             processNeighbor,
+                             opposite,
+                             parallelGridCore->getCommunicator (),
+                             &request);
+    ASSERT (retCode == MPI_SUCCESS);
+    shareRequests.push_back (request);
+
+    grid_coord index = 0;
+    for (size_t i = 0; i < grids.size (); ++i)
+    {
+      ASSERT (grids[i]->getGroup () == this);
+      index += grids[i]->copyToSendBuffer (bufferDirection, shareBuffersSend[bufferDirection].data () + index);
+    }
+    ASSERT (index == count);
+
+    retCode = MPI_Isend (shareBuffersSend[bufferDirection].data (),
+                         count,
+                         MPI_FPVALUE,
+                         processNeighbor,
+                         bufferDirection,
+                         parallelGridCore->getCommunicator (),
+                         &request);
+    ASSERT (retCode == MPI_SUCCESS);
+    shareRequests.push_back (request);
+  }
+#endif /* !DYNAMIC_GRID */
+} /* ParallelGridGroup::startShare */
+
+/**
+ * Finish share operations, started by startShare, and copy received values to buffers of grids
+ */
+void
+ParallelGridGroup::finishShare ()
+{
+#ifndef DYNAMIC_GRID
+  if (shareGrids.empty ())
+  {
+    return;
+  }
+
+  int retCode = MPI_Waitall (shareRequests.size (), shareRequests.data (), MPI_STATUSES_IGNORE);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  shareRequests.clear ();
+
+  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+  {
+    BufferPosition bufferDirection = (BufferPosition) buf;
+    BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
+
+    if (parallelGridCore->getNodeForDirection (bufferDirection) == PID_NONE)
+    {
+      continue;
+    }
+
+    grid_coord index = 0;
+    for (size_t i = 0; i < shareGrids.size (); ++i)
+    {
+      index += shareGrids[i]->copyFromReceiveBuffer (opposite, shareBuffersReceive[bufferDirection].data () + index);
+    }
+    ASSERT (index == getShareCount (bufferDirection, shareGrids));
+  }
+
+  shareGrids.clear ();
+
+  DPRINTF (LOG_LEVEL_FULL, "Finish share of group '%s' PID=%d\n", groupName.c_str (), parallelGridCore->getProcessId ());
+#endif /* !DYNAMIC_GRID */
+} /* ParallelGridGroup::finishShare */
+
 
 /**
  * Initialize start and end cooridnates for send/receive for all directions
@@ -40,6 +40,8 @@ typedef std::vector<VectorBufferValues> VectorBuffers;
 
 #define INVALID_GROUP (-1)
 
+class ParallelGrid;
+
 /**
  * Class with data shared between all members of one parallel group
  */
@@ -146,6 +148,26 @@ private:
 
   int storedSteps;
 
+  /**
+   * Grids, share operations for which are started by startShare and not yet finished by finishShare
+   */
+  std::vector<ParallelGrid *> shareGrids;
+
+  /**
+   * Send buffers for share operations of all grids at once (values of each grid follow values of previous grid)
+   */
+  VectorBuffers shareBuffersSend;
+
+  /**
+   * Receive buffers for share operations of all grids at once
+   */
+  VectorBuffers shareBuffersReceive;
+
+  /**
+   * Requests of started and not yet finished share operations
+   */
+  std::vector<MPI_Request> shareRequests;
+
   /**
    * Name of the parallel grid group.
    */
@@ -236,8 +258,14 @@ public:
 #endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
   void initializeStartPosition (ParallelGridCoordinate);
+  grid_coord scanStartPosition (int, int, grid_coord, bool);
   void gatherStartPosition ();
 
+  bool isShareNode () const;
+  grid_coord getShareCount (BufferPosition, const std::vector<ParallelGrid *> &) const;
+  void startShare (const std::vector<ParallelGrid *> &);
+  void finishShare ();
+
   time_step getShareStepLimit () const
   {
     return shareStepLimit;
@@ -563,6 +591,86 @@ public:
 #endif /* GRID_3D */
   } /* ParallelGridGroup::getComputationEnd */
 
+  /**
+   * Get first coordinate of interior part of computations area, which starts from start. Interior part contains
+   * points, computations for which don't read values from buffers (and, thus, don't depend on values received by
+   * share operations).
+   *
+   * @return first coordinate of interior part of computations area
+   */
+  ParallelGridCoordinate getComputationInteriorStart (const ParallelGridCoordinate & start) const /**< first coordinate
+                                                                                                   *   of computations
+                                                                                                   *   area */
+  {
+    grid_coord left_coord, right_coord, down_coord, up_coord, back_coord, front_coord;
+    initBufferOffsets (left_coord, right_coord, down_coord, up_coord, back_coord, front_coord);
+
+    ParallelGridCoordinate res = start;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+    if (left_coord > 0
+        && res.get1 () < left_coord + 1)
+    {
+      res.set1 (left_coord + 1);
+    }
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    if (down_coord > 0
+        && res.get2 () < down_coord + 1)
+    {
+      res.set2 (down_coord + 1);
+    }
+#endif /* GRID_2D || GRID_3D */
+#ifdef GRID_3D
+    if (back_coord > 0
+        && res.get3 () < back_coord + 1)
+    {
+      res.set3 (back_coord + 1);
+    }
+#endif /* GRID_3D */
+
+    return res;
+  } /* ParallelGridGroup::getComputationInteriorStart */
+
+  /**
+   * Get last coordinate of interior part of computations area, which ends at end (see getComputationInteriorStart)
+   *
+   * @return last coordinate of interior part of computations area
+   */
+  ParallelGridCoordinate getComputationInteriorEnd (const ParallelGridCoordinate & end) const /**< last coordinate
+                                                                                               *   of computations
+                                                                                               *   area */
+  {
+    grid_coord left_coord, right_coord, down_coord, up_coord, back_coord, front_coord;
+    initBufferOffsets (left_coord, right_coord, down_coord, up_coord, back_coord, front_coord);
+
+    ParallelGridCoordinate res = end;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+    if (right_coord > 0
+        && res.get1 () > size.get1 () - right_coord - 1)
+    {
+      res.set1 (size.get1 () - right_coord - 1);
+    }
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    if (up_coord > 0
+        && res.get2 () > size.get2 () - up_coord - 1)
+    {
+      res.set2 (size.get2 () - up_coord - 1);
+    }
+#endif /* GRID_2D || GRID_3D */
+#ifdef GRID_3D
+    if (front_coord > 0
+        && res.get3 () > size.get3 () - front_coord - 1)
+    {
+      res.set3 (size.get3 () - front_coord - 1);
+    }
+#endif /* GRID_3D */
+
+    return res;
+  } /* ParallelGridGroup::getComputationInteriorEnd */
+
   /**
    * Initialize buffer offsets for computational node
    */
@@ -28,6 +28,12 @@
 
 #include <cmath>
 
+/**
+ * Margin (in grid points) around TF/SF border, outside of which points don't need TF/SF update. Points, which need
+ * update, are at most 2 points away from border, so one more point is added to be conservative.
+ */
+#define TFSF_SHELL_MARGIN (3)
+
 /**
  * Yee grid layout which specifies how field components are placed in space
  *
@@ -371,6 +377,19 @@ public:
     return rightBorderPML;
   }
 
+  /**
+   * Get box of points, which don't need PML, i.e. points, all material values for which are read outside of PML.
+   * One point margin is enough to cover material averaging.
+   */
+  CUDA_DEVICE CUDA_HOST TC getPMLFreeStart () const
+  {
+    return shiftBorder (leftBorderPML, 1);
+  }
+  CUDA_DEVICE CUDA_HOST TC getPMLFreeEnd () const
+  {
+    return shiftBorder (rightBorderPML, -1);
+  }
+
   CUDA_DEVICE CUDA_HOST bool isExInPML (TC coord) const
   {
     return isInPML (getExCoordFP (coord));
@@ -411,6 +430,30 @@ public:
   {
     return zeroIncCoordFP;
   }
+
+  /**
+   * Get boxes, difference of which (the shell around TF/SF border) contains all points, which might need TF/SF update,
+   * i.e. doNeedTFSFUpdate*Border might be true only for points inside outer box and outside inner box.
+   * In case borders of total field are inverted, shell is the whole grid.
+   */
+  CUDA_DEVICE CUDA_HOST TC getTFSFShellOuterStart () const
+  {
+    return leftBorderTotalField < rightBorderTotalField ? shiftBorder (leftBorderTotalField, -TFSF_SHELL_MARGIN)
+                                                        : size.getZero ();
+  }
+  CUDA_DEVICE CUDA_HOST TC getTFSFShellOuterEnd () const
+  {
+    return leftBorderTotalField < rightBorderTotalField ? shiftBorder (rightBorderTotalField, TFSF_SHELL_MARGIN)
+                                                        : size;
+  }
+  CUDA_DEVICE CUDA_HOST TC getTFSFShellInnerStart () const
+  {
+    return shiftBorder (leftBorderTotalField, TFSF_SHELL_MARGIN);
+  }
+  CUDA_DEVICE CUDA_HOST TC getTFSFShellInnerEnd () const
+  {
+    return shiftBorder (rightBorderTotalField, -TFSF_SHELL_MARGIN);
+  }
   CUDA_DEVICE CUDA_HOST bool doNeedTFSFUpdateExBorder (TC, LayoutDirection) const;
   CUDA_DEVICE CUDA_HOST bool doNeedTFSFUpdateEyBorder (TC, LayoutDirection) const;
   CUDA_DEVICE CUDA_HOST bool doNeedTFSFUpdateEzBorder (TC, LayoutDirection) const;
@@ -486,6 +529,28 @@ public:
 private:
 
   CUDA_DEVICE CUDA_HOST bool isInPML (TCFP realCoordFP) const;
+
+  /**
+   * Shift all coordinates of border by diff, clamping them to grid size
+   *
+   * @return shifted border
+   */
+  CUDA_DEVICE CUDA_HOST TC shiftBorder (TC border, /**< border to shift */
+                                        grid_coord diff) const /**< shift of each coordinate */
+  {
+    GridCoordinate3D border3D = expandTo3D (border, ct1, ct2, ct3);
+    GridCoordinate3D size3D = expandTo3D (size, ct1, ct2, ct3);
+
+    grid_coord coords[3] = { border3D.get1 () + diff, border3D.get2 () + diff, border3D.get3 () + diff };
+    grid_coord sizes[3] = { size3D.get1 (), size3D.get2 (), size3D.get3 () };
+
+    for (int i = 0; i < 3; ++i)
+    {
+      coords[i] = coords[i] < 0 ? 0 : (coords[i] > sizes[i] ? sizes[i] : coords[i]);
+    }
+
+    return TC::initAxesCoordinate (coords[0], coords[1], coords[2], ct1, ct2, ct3);
+  }
 }; /* YeeGridLayout */
 
 class YeeGridLayoutHelper
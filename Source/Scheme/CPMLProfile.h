@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2019 Gleb Balykov
+ *
+ * This file is part of fdtd3d.
+ *
+ * fdtd3d is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * fdtd3d is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with fdtd3d; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CPML_PROFILE_H
+#define CPML_PROFILE_H
+
+#include <vector>
+
+#include "PAssert.h"
+#include "FieldValue.h"
+#include "GridCoordinate3D.h"
+
+/**
+ * Coefficients of recursive convolution of CPML for derivative along one axis in update of one field.
+ *
+ * Coefficients depend only on depth of point in PML along this axis, so they are stored for each coordinate along
+ * the axis. For points outside of PML convolution term is always zero and kappa is 1, so these points are the same
+ * as points, which are updated without CPML.
+ */
+class CPMLProfile
+{
+  /**
+   * Axis of derivative
+   */
+  CoordinateType axis;
+
+  /**
+   * Coefficients of recursive convolution psi = b * psi + c * derivative
+   */
+  std::vector<FPValue> b;
+  std::vector<FPValue> c;
+
+  /**
+   * Inverse of real coordinate stretching, by which derivative is multiplied
+   */
+  std::vector<FPValue> kappaInv;
+
+public:
+
+  /**
+   * Constructor. All points are initialized as points outside of PML.
+   */
+  CPMLProfile (CoordinateType axisType, /**< axis of derivative */
+               grid_coord size) /**< size of grid along the axis */
+  : axis (axisType)
+  , b (size, FPValue (0))
+  , c (size, FPValue (0))
+  , kappaInv (size, FPValue (1))
+  {
+    ASSERT (axis == CoordinateType::X || axis == CoordinateType::Y || axis == CoordinateType::Z);
+    ASSERT (size > 0);
+  } /* CPMLProfile */
+
+  /**
+   * Set coefficients for coordinate along the axis
+   */
+  void set (grid_coord index, /**< coordinate along the axis */
+            FPValue valB, /**< coefficient b */
+            FPValue valC, /**< coefficient c */
+            FPValue valKappaInv) /**< inverse of kappa */
+  {
+    ASSERT (index >= 0 && index < (grid_coord) b.size ());
+    b[index] = valB;
+    c[index] = valC;
+    kappaInv[index] = valKappaInv;
+  } /* set */
+
+  /**
+   * Get coordinate of position along the axis
+   *
+   * @return coordinate along the axis
+   */
+  template <typename TcoordType, bool doSignChecks>
+  static TcoordType getAxisCoordinate (const GridCoordinate3DTemplate<TcoordType, doSignChecks> &pos, /**< position */
+                                       CoordinateType axisType) /**< axis */
+  {
+    switch (axisType)
+    {
+      case CoordinateType::X:
+      {
+        return pos.get1 ();
+      }
+      case CoordinateType::Y:
+      {
+        return pos.get2 ();
+      }
+      case CoordinateType::Z:
+      {
+        return pos.get3 ();
+      }
+      default:
+      {
+        UNREACHABLE;
+      }
+    }
+
+    return TcoordType (0);
+  } /* getAxisCoordinate */
+
+  /**
+   * Get coordinate of position along the axis of derivative
+   *
+   * @return coordinate along the axis
+   */
+  grid_coord getIndex (const GridCoordinate3D &posAbs) const /**< absolute position */
+  {
+    return getAxisCoordinate (posAbs, axis);
+  } /* getIndex */
+
+  /**
+   * Get axis of derivative
+   *
+   * @return axis
+   */
+  CoordinateType getAxis () const
+  {
+    return axis;
+  } /* getAxis */
+
+  /**
+   * Get coefficient b
+   *
+   * @return coefficient b
+   */
+  const FPValue & getB (grid_coord index) const /**< coordinate along the axis */
+  {
+    ASSERT (index >= 0 && index < (grid_coord) b.size ());
+    return b[index];
+  } /* getB */
+
+  /**
+   * Get coefficient c
+   *
+   * @return coefficient c
+   */
+  const FPValue & getC (grid_coord index) const /**< coordinate along the axis */
+  {
+    ASSERT (index >= 0 && index < (grid_coord) c.size ());
+    return c[index];
+  } /* getC */
+
+  /**
+   * Get inverse of kappa
+   *
+   * @return inverse of kappa
+   */
+  const FPValue & getKappaInv (grid_coord index) const /**< coordinate along the axis */
+  {
+    ASSERT (index >= 0 && index < (grid_coord) kappaInv.size ());
+    return kappaInv[index];
+  } /* getKappaInv */
+}; /* CPMLProfile */
+
+#endif /* CPML_PROFILE_H */
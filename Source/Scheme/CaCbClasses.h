@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2019 Gleb Balykov
+ *
+ * This file is part of fdtd3d.
+ *
+ * fdtd3d is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * fdtd3d is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with fdtd3d; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CA_CB_CLASSES_H
+#define CA_CB_CLASSES_H
+
+#include <vector>
+
+#include "PAssert.h"
+#include "FieldValue.h"
+
+/**
+ * Maximum number of distinct pairs of Ca and Cb coefficients, which are stored in table
+ */
+#define CA_CB_CLASSES_MAX_COUNT (16)
+
+/**
+ * Class of point, coefficients of which are not stored in table and should be computed on each time step
+ */
+#define CA_CB_CLASS_NONE (0xFF)
+
+/**
+ * Class of point, which is never computed (e.g. border of grid), so its coefficients are never needed
+ */
+#define CA_CB_CLASS_SKIP (0xFE)
+
+/**
+ * Minimum length of run of points with the same class in row, for which scalar coefficients are used
+ */
+#define CA_CB_CLASSES_MIN_RUN (16)
+
+/**
+ * Compact storage of Ca and Cb coefficients of general FDTD update for grids with few distinct materials.
+ *
+ * Each point of grid stores one byte index of its class, and coefficients of classes are stored in small table.
+ * Besides, runs of points with the same class in rows of grid are tagged, so that the whole run could be computed
+ * with scalar coefficients without any loads of per-point data.
+ *
+ * Points are identified by linear index in raw storage of grid (see VectorFieldValues), rows are contiguous.
+ */
+class CaCbClasses
+{
+  /**
+   * Run of points with the same class in a row, [start, end) in linear indexes
+   */
+  struct Run
+  {
+    grid_coord start;
+    grid_coord end;
+    uint8_t classIndex;
+  };
+
+  /**
+   * Length of rows of grid
+   */
+  grid_coord rowLength;
+
+  /**
+   * Class of each point of grid
+   */
+  std::vector<uint8_t> classes;
+
+  /**
+   * Runs of all rows, sorted by start
+   */
+  std::vector<Run> runs;
+
+  /**
+   * Index of first run of each row in runs (one extra element for the end of the last row)
+   */
+  std::vector<grid_coord> rowRuns;
+
+  /**
+   * Table of coefficients of classes
+   */
+  FieldValue ca[CA_CB_CLASSES_MAX_COUNT];
+  FieldValue cb[CA_CB_CLASSES_MAX_COUNT];
+
+  /**
+   * Number of classes in table
+   */
+  uint8_t classCount;
+
+public:
+
+  /**
+   * Constructor. All points are initialized as never computed.
+   */
+  CaCbClasses (grid_coord count, /**< number of points in grid */
+               grid_coord length) /**< length of rows of grid */
+  : rowLength (length)
+  , classes (count, CA_CB_CLASS_SKIP)
+  , classCount (0)
+  {
+    ASSERT (count > 0);
+    ASSERT (rowLength > 0 && count % rowLength == 0);
+  } /* CaCbClasses */
+
+  /**
+   * Add class with specified coefficients to table
+   *
+   * @return index of added class
+   */
+  uint8_t addClass (FieldValue valCa, /**< Ca coefficient */
+                    FieldValue valCb) /**< Cb coefficient */
+  {
+    ASSERT (classCount < CA_CB_CLASSES_MAX_COUNT);
+    ca[classCount] = valCa;
+    cb[classCount] = valCb;
+    return classCount++;
+  } /* addClass */
+
+  /**
+   * Set class of point
+   */
+  void setClass (grid_coord index, /**< linear index of point */
+                 uint8_t classIndex) /**< class of point */
+  {
+    ASSERT (classIndex < classCount || classIndex == CA_CB_CLASS_NONE || classIndex == CA_CB_CLASS_SKIP);
+    classes[index] = classIndex;
+  } /* setClass */
+
+  /**
+   * Tag runs of points with the same class in all rows. Should be called after classes of all points are set.
+   * Points, which are never computed, do not break runs.
+   */
+  void initRuns ()
+  {
+    grid_coord rowCount = ((grid_coord) classes.size ()) / rowLength;
+
+    runs.clear ();
+    rowRuns.resize (rowCount + 1);
+
+    for (grid_coord row = 0; row < rowCount; ++row)
+    {
+      rowRuns[row] = (grid_coord) runs.size ();
+
+      grid_coord rowStart = row * rowLength;
+      grid_coord rowEnd = rowStart + rowLength;
+
+      Run run;
+      run.start = rowStart;
+      run.classIndex = CA_CB_CLASS_SKIP;
+
+      for (grid_coord index = rowStart; index <= rowEnd; ++index)
+      {
+        uint8_t classIndex = index < rowEnd ? classes[index] : CA_CB_CLASS_NONE;
+        if (classIndex == CA_CB_CLASS_SKIP
+            || classIndex == run.classIndex)
+        {
+          continue;
+        }
+
+        if (run.classIndex == CA_CB_CLASS_SKIP)
+        {
+          run.classIndex = classIndex;
+          continue;
+        }
+
+        run.end = index;
+        if (run.classIndex != CA_CB_CLASS_NONE
+            && run.end - run.start >= CA_CB_CLASSES_MIN_RUN)
+        {
+          runs.push_back (run);
+        }
+
+        run.start = index;
+        run.classIndex = classIndex;
+      }
+    }
+
+    rowRuns[rowCount] = (grid_coord) runs.size ();
+  } /* initRuns */
+
+  /**
+   * Get segment of row, which starts at specified point and either belongs to one run, or contains no points of runs
+   *
+   * @return class of run, to which segment belongs, or CA_CB_CLASS_NONE if segment is not in run
+   */
+  uint8_t getSegment (grid_coord index, /**< linear index of first point of segment */
+                      grid_coord endIndex, /**< linear index of the end of part of row, which is computed */
+                      grid_coord &segmentEnd) const /**< out: linear index of the end of segment */
+  {
+    ASSERT (index < endIndex);
+    ASSERT (index / rowLength == (endIndex - 1) / rowLength);
+
+    grid_coord row = index / rowLength;
+
+    /*
+     * Find the first run of row, which ends after index
+     */
+    grid_coord left = rowRuns[row];
+    grid_coord right = rowRuns[row + 1];
+    while (left < right)
+    {
+      grid_coord middle = left + (right - left) / 2;
+      if (runs[middle].end <= index)
+      {
+        left = middle + 1;
+      }
+      else
+      {
+        right = middle;
+      }
+    }
+
+    segmentEnd = endIndex;
+
+    if (left == rowRuns[row + 1])
+    {
+      return CA_CB_CLASS_NONE;
+    }
+
+    const Run &run = runs[left];
+    if (run.start <= index)
+    {
+      if (run.end < segmentEnd)
+      {
+        segmentEnd = run.end;
+      }
+      return run.classIndex;
+    }
+
+    if (run.start < segmentEnd)
+    {
+      segmentEnd = run.start;
+    }
+    return CA_CB_CLASS_NONE;
+  } /* getSegment */
+
+  /**
+   * Get classes of points
+   *
+   * @return pointer to class of point with zero linear index
+   */
+  const uint8_t * getClasses () const
+  {
+    return &classes[0];
+  } /* getClasses */
+
+  /**
+   * Get Ca coefficient of class
+   *
+   * @return Ca coefficient
+   */
+  const FieldValue & getCa (uint8_t classIndex) const /**< class */
+  {
+    ASSERT (classIndex < classCount);
+    return ca[classIndex];
+  } /* getCa */
+
+  /**
+   * Get Cb coefficient of class
+   *
+   * @return Cb coefficient
+   */
+  const FieldValue & getCb (uint8_t classIndex) const /**< class */
+  {
+    ASSERT (classIndex < classCount);
+    return cb[classIndex];
+  } /* getCb */
+
+  /**
+   * Get number of classes in table
+   *
+   * @return number of classes
+   */
+  uint8_t getClassCount () const
+  {
+    return classCount;
+  } /* getClassCount */
+
+  /**
+   * Get number of tagged runs
+   *
+   * @return number of runs
+   */
+  grid_coord getRunCount () const
+  {
+    return (grid_coord) runs.size ();
+  } /* getRunCount */
+}; /* CaCbClasses */
+
+#endif /* CA_CB_CLASSES_H */
@@ -94,6 +94,22 @@ GRID_NAME(DaPMLHz)
 GRID_NAME(DbPMLHz)
 GRID_NAME(DcPMLHz)
 
+/**
+ * Auxiliary grids of recursive convolution of CPML
+ */
+GRID_NAME(PsiExY)
+GRID_NAME(PsiExZ)
+GRID_NAME(PsiEyZ)
+GRID_NAME(PsiEyX)
+GRID_NAME(PsiEzX)
+GRID_NAME(PsiEzY)
+GRID_NAME(PsiHxZ)
+GRID_NAME(PsiHxY)
+GRID_NAME(PsiHyX)
+GRID_NAME(PsiHyZ)
+GRID_NAME(PsiHzY)
+GRID_NAME(PsiHzX)
+
 /**
  * Auxiliary field grids used for metamaterials with PML
  */
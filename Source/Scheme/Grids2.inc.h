@@ -26,6 +26,33 @@
  * NOTE: time offsets for all the grids should be in sync with share process!
  */
 
+/*
+ * Field grids could be allocated specially, e.g. to be updated in place (see InternalSchemeHelper::allocateGrids).
+ * By default they are the same as other grids.
+ */
+#ifndef GRID_NAME_FIELD
+#define GRID_NAME_FIELD(x, y, steps, time_offset) GRID_NAME(x, y, steps, time_offset)
+#define GRID_NAME_FIELD_DEFAULT
+#endif /* !GRID_NAME_FIELD */
+
+/*
+ * Grids, which are needed only in PML, could be allocated specially too, e.g. to store values only in PML.
+ * By default they are the same as other grids.
+ */
+#ifndef GRID_NAME_PML
+#define GRID_NAME_PML(x, y, steps, time_offset) GRID_NAME(x, y, steps, time_offset)
+#define GRID_NAME_PML_DEFAULT
+#endif /* !GRID_NAME_PML */
+
+/*
+ * Auxiliary grids of CPML for derivative along the specified axis are needed only in PML slabs along this axis.
+ * By default they are the same as other grids.
+ */
+#ifndef GRID_NAME_CPML
+#define GRID_NAME_CPML(x, y, axis, steps, time_offset) GRID_NAME(x, y, steps, time_offset)
+#define GRID_NAME_CPML_DEFAULT
+#endif /* !GRID_NAME_CPML */
+
 /**
  * Material grids
  */
@@ -35,12 +62,12 @@ GRID_NAME_NO_CHECK(Mu, Eps, 1, 0)
 /**
  * Field grids
  */
-GRID_NAME(Ex, Ex, storedSteps, 1)
-GRID_NAME(Ey, Ey, storedSteps, 1)
-GRID_NAME(Ez, Ez, storedSteps, 1)
-GRID_NAME(Hx, Hx, storedSteps, 0)
-GRID_NAME(Hy, Hy, storedSteps, 0)
-GRID_NAME(Hz, Hz, storedSteps, 0)
+GRID_NAME_FIELD(Ex, Ex, storedSteps, 1)
+GRID_NAME_FIELD(Ey, Ey, storedSteps, 1)
+GRID_NAME_FIELD(Ez, Ez, storedSteps, 1)
+GRID_NAME_FIELD(Hx, Hx, storedSteps, 0)
+GRID_NAME_FIELD(Hy, Hy, storedSteps, 0)
+GRID_NAME_FIELD(Hz, Hz, storedSteps, 0)
 
 if (SOLVER_SETTINGS.getDoUseCaCbGrids ())
 {
@@ -66,12 +93,12 @@ if (SOLVER_SETTINGS.getDoUsePML ())
   /**
    * Helper grids used for PML
    */
-  GRID_NAME(Dx, Ex, storedSteps, 1)
-  GRID_NAME(Dy, Ey, storedSteps, 1)
-  GRID_NAME(Dz, Ez, storedSteps, 1)
-  GRID_NAME(Bx, Hx, storedSteps, 0)
-  GRID_NAME(By, Hy, storedSteps, 0)
-  GRID_NAME(Bz, Hz, storedSteps, 0)
+  GRID_NAME_PML(Dx, Ex, storedSteps, 1)
+  GRID_NAME_PML(Dy, Ey, storedSteps, 1)
+  GRID_NAME_PML(Dz, Ez, storedSteps, 1)
+  GRID_NAME_PML(Bx, Hx, storedSteps, 0)
+  GRID_NAME_PML(By, Hy, storedSteps, 0)
+  GRID_NAME_PML(Bz, Hz, storedSteps, 0)
 
   /**
    * Sigmas
@@ -85,29 +112,49 @@ if (SOLVER_SETTINGS.getDoUsePML ())
     /**
      * Helper grids for PML
      */
-    GRID_NAME(CaPMLEx, Ex, 1, 1)
-    GRID_NAME(CbPMLEx, Ex, 1, 1)
-    GRID_NAME(CcPMLEx, Ex, 1, 1)
+    GRID_NAME_PML(CaPMLEx, Ex, 1, 1)
+    GRID_NAME_PML(CbPMLEx, Ex, 1, 1)
+    GRID_NAME_PML(CcPMLEx, Ex, 1, 1)
 
-    GRID_NAME(CaPMLEy, Ey, 1, 1)
-    GRID_NAME(CbPMLEy, Ey, 1, 1)
-    GRID_NAME(CcPMLEy, Ey, 1, 1)
+    GRID_NAME_PML(CaPMLEy, Ey, 1, 1)
+    GRID_NAME_PML(CbPMLEy, Ey, 1, 1)
+    GRID_NAME_PML(CcPMLEy, Ey, 1, 1)
 
-    GRID_NAME(CaPMLEz, Ez, 1, 1)
-    GRID_NAME(CbPMLEz, Ez, 1, 1)
-    GRID_NAME(CcPMLEz, Ez, 1, 1)
+    GRID_NAME_PML(CaPMLEz, Ez, 1, 1)
+    GRID_NAME_PML(CbPMLEz, Ez, 1, 1)
+    GRID_NAME_PML(CcPMLEz, Ez, 1, 1)
 
-    GRID_NAME(DaPMLHx, Hx, 1, 0)
-    GRID_NAME(DbPMLHx, Hx, 1, 0)
-    GRID_NAME(DcPMLHx, Hx, 1, 0)
+    GRID_NAME_PML(DaPMLHx, Hx, 1, 0)
+    GRID_NAME_PML(DbPMLHx, Hx, 1, 0)
+    GRID_NAME_PML(DcPMLHx, Hx, 1, 0)
 
-    GRID_NAME(DaPMLHy, Hy, 1, 0)
-    GRID_NAME(DbPMLHy, Hy, 1, 0)
-    GRID_NAME(DcPMLHy, Hy, 1, 0)
+    GRID_NAME_PML(DaPMLHy, Hy, 1, 0)
+    GRID_NAME_PML(DbPMLHy, Hy, 1, 0)
+    GRID_NAME_PML(DcPMLHy, Hy, 1, 0)
 
-    GRID_NAME(DaPMLHz, Hz, 1, 0)
-    GRID_NAME(DbPMLHz, Hz, 1, 0)
-    GRID_NAME(DcPMLHz, Hz, 1, 0)
+    GRID_NAME_PML(DaPMLHz, Hz, 1, 0)
+    GRID_NAME_PML(DbPMLHz, Hz, 1, 0)
+    GRID_NAME_PML(DcPMLHz, Hz, 1, 0)
+  }
+
+  if (SOLVER_SETTINGS.getDoUseCPML ())
+  {
+    /**
+     * Auxiliary grids of recursive convolution of CPML, one for each derivative in curl (e.g. PsiExY is for dHz/dy in
+     * update of Ex). Values are updated in place, so a single time layer is stored.
+     */
+    GRID_NAME_CPML(PsiExY, Ex, Y, 1, 1)
+    GRID_NAME_CPML(PsiExZ, Ex, Z, 1, 1)
+    GRID_NAME_CPML(PsiEyZ, Ey, Z, 1, 1)
+    GRID_NAME_CPML(PsiEyX, Ey, X, 1, 1)
+    GRID_NAME_CPML(PsiEzX, Ez, X, 1, 1)
+    GRID_NAME_CPML(PsiEzY, Ez, Y, 1, 1)
+    GRID_NAME_CPML(PsiHxZ, Hx, Z, 1, 0)
+    GRID_NAME_CPML(PsiHxY, Hx, Y, 1, 0)
+    GRID_NAME_CPML(PsiHyX, Hy, X, 1, 0)
+    GRID_NAME_CPML(PsiHyZ, Hy, Z, 1, 0)
+    GRID_NAME_CPML(PsiHzY, Hz, Y, 1, 0)
+    GRID_NAME_CPML(PsiHzX, Hz, X, 1, 0)
   }
 
   if (SOLVER_SETTINGS.getDoUseMetamaterials ())
@@ -176,3 +223,18 @@ if (SOLVER_SETTINGS.getDoUseMetamaterials ())
   GRID_NAME_NO_CHECK(OmegaPM, Eps, 1, 0)
   GRID_NAME_NO_CHECK(GammaM, Eps, 1, 0)
 }
+
+#ifdef GRID_NAME_FIELD_DEFAULT
+#undef GRID_NAME_FIELD
+#undef GRID_NAME_FIELD_DEFAULT
+#endif /* GRID_NAME_FIELD_DEFAULT */
+
+#ifdef GRID_NAME_PML_DEFAULT
+#undef GRID_NAME_PML
+#undef GRID_NAME_PML_DEFAULT
+#endif /* GRID_NAME_PML_DEFAULT */
+
+#ifdef GRID_NAME_CPML_DEFAULT
+#undef GRID_NAME_CPML
+#undef GRID_NAME_CPML_DEFAULT
+#endif /* GRID_NAME_CPML_DEFAULT */
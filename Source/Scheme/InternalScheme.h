@@ -26,11 +26,18 @@
 #include "YeeGridLayout.h"
 #include "ParallelYeeGridLayout.h"
 #include "CallBack.h"
+#include "CaCbClasses.h"
+#include "CPMLProfile.h"
 
 /**
  * InternalScheme is implemented without virtual functions in order to be copied to GPU (classes with vtable can't be)
  */
 
+/**
+ * Number of points, which are processed by row kernels at once
+ */
+#define INTERNAL_SCHEME_ROW_CHUNK (128)
+
 /*
  * Forward declaration of both CPU and GPU internal schemes
  */
@@ -495,6 +495,26 @@ public:
   ICUDA_HOST
   static void allocateGridsInc (InternalScheme<Type, TCoord, layout_type> *intScheme, YeeGridLayout<Type, TCoord, layout_type> *layout);
 
+  template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+  ICUDA_HOST
+  static Grid< TCoord<grid_coord, true> > * allocatePMLGrid (InternalScheme<Type, TCoord, layout_type> *intScheme,
+                                                              YeeGridLayout<Type, TCoord, layout_type> *layout,
+                                                              TCoord<grid_coord, true>, int, const char *);
+
+  template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+  ICUDA_HOST
+  static Grid< TCoord<grid_coord, true> > * allocateCPMLGrid (InternalScheme<Type, TCoord, layout_type> *intScheme,
+                                                               YeeGridLayout<Type, TCoord, layout_type> *layout,
+                                                               TCoord<grid_coord, true>, CoordinateType, int, const char *);
+
+  template <template <typename, bool> class TCoord>
+  ICUDA_HOST
+  static void getBorderStrips (TCoord<grid_coord, true>, TCoord<grid_coord, true>,
+                               TCoord<grid_coord, true>, TCoord<grid_coord, true>,
+                               std::vector< TCoord<grid_coord, true> > &, std::vector< TCoord<grid_coord, true> > &,
+                               TCoord<grid_coord, true> &, TCoord<grid_coord, true> &,
+                               CoordinateType, CoordinateType, CoordinateType);
+
 #endif /* !GPU_INTERNAL_SCHEME */
 
   ICUDA_DEVICE
@@ -786,6 +806,40 @@ private:
     return prevEOrH * Ca + curDOrB * Cb - prevDOrB * Cc;
   }
 
+#ifndef GPU_INTERNAL_SCHEME
+  /**
+   * Same as calcField for contiguous rows of values and without right side. Loop has no dependencies between
+   * iterations, so compiler could vectorize it. Current and previous values might be the same (for grids, which are
+   * updated in place).
+   */
+  static void calcFieldRow (FieldValue *cur, const FieldValue *prev,
+                            const FieldValue *oppositeField11, const FieldValue *oppositeField12,
+                            const FieldValue *oppositeField21, const FieldValue *oppositeField22,
+                            const FieldValue *Ca, const FieldValue *Cb, grid_coord count)
+  {
+    for (grid_coord k = 0; k < count; ++k)
+    {
+      FieldValue tmp = oppositeField12[k] - oppositeField11[k] - oppositeField22[k] + oppositeField21[k];
+      cur[k] = prev[k] * Ca[k] + tmp * Cb[k];
+    }
+  }
+
+  /**
+   * Same as calcFieldRow for rows of points with the same coefficients.
+   */
+  static void calcFieldRowUniform (FieldValue *cur, const FieldValue *prev,
+                                   const FieldValue *oppositeField11, const FieldValue *oppositeField12,
+                                   const FieldValue *oppositeField21, const FieldValue *oppositeField22,
+                                   FieldValue Ca, FieldValue Cb, grid_coord count)
+  {
+    for (grid_coord k = 0; k < count; ++k)
+    {
+      FieldValue tmp = oppositeField12[k] - oppositeField11[k] - oppositeField22[k] + oppositeField21[k];
+      cur[k] = prev[k] * Ca + tmp * Cb;
+    }
+  }
+#endif /* !GPU_INTERNAL_SCHEME */
+
 public:
 
   ICUDA_DEVICE
@@ -806,6 +860,20 @@ public:
                                     IGRID<TC> *, IGRID<TC> *, SourceCallBack, IGRID<TC> *, IGRID<TC> *, bool,
                                     GridType, IGRID<TC> *, GridType, FPValue);
 
+#ifndef GPU_INTERNAL_SCHEME
+  template <uint8_t grid_type, bool usePrecomputedGrids>
+  ICUDA_HOST
+  void calculateFieldStepIterationRow (TC, TC, TC, grid_coord, TCS, TCS, TCS, TCS, IGRID<TC> *,
+                                       IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, const CaCbClasses *, bool,
+                                       GridType, IGRID<TC> *, GridType, FPValue);
+
+  template <uint8_t grid_type, bool usePrecomputedGrids>
+  ICUDA_HOST
+  void calculateFieldStepIterationCPML (TC, TC, TCS, TCS, TCS, TCS, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *,
+                                        IGRID<TC> *, IGRID<TC> *, const CPMLProfile *, const CPMLProfile *,
+                                        IGRID<TC> *, IGRID<TC> *, GridType, IGRID<TC> *, GridType, FPValue);
+#endif /* !GPU_INTERNAL_SCHEME */
+
   template <uint8_t grid_type, bool usePrecomputedGrids>
   ICUDA_DEVICE
   void calculateFieldStepIterationCurrent (FieldValue, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *,
@@ -823,6 +891,10 @@ public:
   template <uint8_t grid_type>
   ICUDA_HOST
   void calculateFieldStepInitDiff (TCS *, TCS *, TCS *, TCS *);
+
+  template <uint8_t grid_type>
+  ICUDA_HOST
+  void calculateFieldStepInitCPML (IGRID<TC> **, IGRID<TC> **);
 #endif
 
   template <bool usePrecomputedGrids>
@@ -1897,6 +1969,61 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepInitDiff (TCS
     }
   }
 }
+
+/**
+ * Initialize auxiliary grids of CPML for both derivatives in curl, in the same order as terms of curl
+ * (see calculateFieldStepInitDiff). Grid is NULLPTR if derivative is not computed in this scheme.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template<uint8_t grid_type>
+ICUDA_HOST
+void
+INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepInitCPML (IGRID<TC> **psi1, IGRID<TC> **psi2)
+{
+  switch (grid_type)
+  {
+    case (static_cast<uint8_t> (GridType::EX)):
+    {
+      *psi1 = PsiExY;
+      *psi2 = PsiExZ;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::EY)):
+    {
+      *psi1 = PsiEyZ;
+      *psi2 = PsiEyX;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::EZ)):
+    {
+      *psi1 = PsiEzX;
+      *psi2 = PsiEzY;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HX)):
+    {
+      *psi1 = PsiHxZ;
+      *psi2 = PsiHxY;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HY)):
+    {
+      *psi1 = PsiHyX;
+      *psi2 = PsiHyZ;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HZ)):
+    {
+      *psi1 = PsiHzY;
+      *psi2 = PsiHzX;
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+}
 #endif
 
 /**
@@ -2416,6 +2543,279 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIteration (FP
   grid->setFieldValue (valNew, pos, 0);
 }
 
+#ifndef GPU_INTERNAL_SCHEME
+/**
+ * Perform computations for the row of points, starting at pos and having count points (only last coordinate changes).
+ * Is equivalent to calculateFieldStepIteration for each of the points of the row in case TF/SF and right side are not used.
+ *
+ * If classes of coefficients are specified, coefficients of points are taken from table of classes, and tagged runs
+ * of points with the same class are computed with scalar coefficients. Coefficients of points without class are
+ * computed as usual.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template<uint8_t grid_type, bool usePrecomputedGrids>
+ICUDA_HOST
+void
+INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationRow (TC pos, /**< first point of row */
+                                                                                TC posAbs, /**< absolute position of first point of row */
+                                                                                TC end, /**< end of the chunk, which contains row */
+                                                                                grid_coord count, /**< number of points in row */
+                                                                                TCS diff11,
+                                                                                TCS diff12,
+                                                                                TCS diff21,
+                                                                                TCS diff22,
+                                                                                IGRID<TC> *grid,
+                                                                                IGRID<TC> *oppositeGrid1,
+                                                                                IGRID<TC> *oppositeGrid2,
+                                                                                IGRID<TC> *Ca,
+                                                                                IGRID<TC> *Cb,
+                                                                                const CaCbClasses *classes, /**< classes of coefficients or NULLPTR */
+                                                                                bool usePML,
+                                                                                GridType gridType,
+                                                                                IGRID<TC> *materialGrid,
+                                                                                GridType materialGridType,
+                                                                                FPValue materialModifier)
+{
+  ASSERT (grid != NULLPTR);
+  ASSERT (count > 0);
+  ASSERT (classes == NULLPTR || !usePrecomputedGrids);
+
+  /*
+   * Rows are contiguous in raw storage, so all values of row are accessed through pointer to the first one.
+   * For grids, which are updated in place, current and previous rows are the same.
+   */
+  FieldValue *rowCur = grid->getFieldValue (pos, 0);
+  const FieldValue *rowPrev = grid->getFieldValue (pos, 1);
+
+  FieldValue zeroChunk[INTERNAL_SCHEME_ROW_CHUNK];
+  FieldValue caChunk[INTERNAL_SCHEME_ROW_CHUNK];
+  FieldValue cbChunk[INTERNAL_SCHEME_ROW_CHUNK];
+
+  const FieldValue *row11 = zeroChunk;
+  const FieldValue *row12 = zeroChunk;
+  const FieldValue *row21 = zeroChunk;
+  const FieldValue *row22 = zeroChunk;
+
+  /*
+   * Step of pointers to opposite fields between points (zero for absent opposite fields)
+   */
+  grid_coord step1 = 0;
+  grid_coord step2 = 0;
+
+  if (oppositeGrid1 == NULLPTR || oppositeGrid2 == NULLPTR)
+  {
+    for (grid_coord k = 0; k < INTERNAL_SCHEME_ROW_CHUNK; ++k)
+    {
+      zeroChunk[k] = FIELDVALUE (0, 0);
+    }
+  }
+
+  if (oppositeGrid1)
+  {
+    row11 = oppositeGrid1->getFieldValue (pos + diff11, 1);
+    row12 = oppositeGrid1->getFieldValue (pos + diff12, 1);
+    step1 = 1;
+  }
+
+  if (oppositeGrid2)
+  {
+    row21 = oppositeGrid2->getFieldValue (pos + diff21, 1);
+    row22 = oppositeGrid2->getFieldValue (pos + diff22, 1);
+    step2 = 1;
+  }
+
+  const FieldValue *rowCa = NULLPTR;
+  const FieldValue *rowCb = NULLPTR;
+  if (usePrecomputedGrids)
+  {
+    rowCa = Ca->getFieldValue (pos, 0);
+    rowCb = Cb->getFieldValue (pos, 0);
+  }
+
+  /*
+   * Linear index of the first point of row in full grid, through which classes of points are accessed
+   * (grids of PML auxiliary fields might be partial, so their raw storage is not used for this)
+   */
+  grid_coord index = 0;
+  const uint8_t *rowClasses = NULLPTR;
+  if (classes != NULLPTR)
+  {
+    index = VectorFieldValues<TC>::calculateIndex (pos, grid->getSize ());
+    rowClasses = classes->getClasses () + index;
+  }
+
+  /*
+   * Row is split into segments, each of which either belongs to a run of points with the same class, or not
+   */
+  grid_coord segmentStart = 0;
+  while (segmentStart < count)
+  {
+    grid_coord segmentEnd = count;
+    uint8_t segmentClass = CA_CB_CLASS_NONE;
+
+    if (classes != NULLPTR)
+    {
+      segmentClass = classes->getSegment (index + segmentStart, index + count, segmentEnd);
+      segmentEnd -= index;
+    }
+
+    for (grid_coord chunkStart = segmentStart; chunkStart < segmentEnd; chunkStart += INTERNAL_SCHEME_ROW_CHUNK)
+    {
+      grid_coord chunkSize = segmentEnd - chunkStart;
+      if (chunkSize > INTERNAL_SCHEME_ROW_CHUNK)
+      {
+        chunkSize = INTERNAL_SCHEME_ROW_CHUNK;
+      }
+
+      if (segmentClass != CA_CB_CLASS_NONE)
+      {
+        calcFieldRowUniform (rowCur + chunkStart, rowPrev + chunkStart,
+                             row11 + chunkStart * step1, row12 + chunkStart * step1,
+                             row21 + chunkStart * step2, row22 + chunkStart * step2,
+                             classes->getCa (segmentClass), classes->getCb (segmentClass), chunkSize);
+        continue;
+      }
+
+      const FieldValue *chunkCa = caChunk;
+      const FieldValue *chunkCb = cbChunk;
+
+      if (usePrecomputedGrids)
+      {
+        chunkCa = rowCa + chunkStart;
+        chunkCb = rowCb + chunkStart;
+      }
+      else
+      {
+        /*
+         * Coefficients depend on averaged materials, so they are either taken from table of classes,
+         * or computed point by point before the update itself
+         */
+        for (grid_coord k = 0; k < chunkSize; ++k)
+        {
+          uint8_t classIndex = rowClasses ? rowClasses[chunkStart + k] : CA_CB_CLASS_NONE;
+          if (classIndex != CA_CB_CLASS_NONE)
+          {
+            caChunk[k] = classes->getCa (classIndex);
+            cbChunk[k] = classes->getCb (classIndex);
+            continue;
+          }
+
+          TC curPos = VectorFieldValues<TC>::getPosition (pos, end, chunkStart + k);
+          computeCaCb<usePrecomputedGrids> (caChunk[k], cbChunk[k], curPos, posAbs + (curPos - pos), Ca, Cb,
+                                            usePML, gridType, materialGrid, materialGridType, materialModifier);
+        }
+      }
+
+      calcFieldRow (rowCur + chunkStart, rowPrev + chunkStart,
+                    row11 + chunkStart * step1, row12 + chunkStart * step1,
+                    row21 + chunkStart * step2, row22 + chunkStart * step2,
+                    chunkCa, chunkCb, chunkSize);
+    }
+
+    segmentStart = segmentEnd;
+  }
+}
+
+/**
+ * Add terms of CPML to the value of point, which is already updated without PML (i.e. with kappa equal to 1 and
+ * without convolution terms), and update auxiliary convolution values of point.
+ *
+ * Update with CPML differs from update without PML only by derivatives in curl, each of which is replaced with
+ * derivative / kappa + psi, where psi = b * psi + c * derivative. Update is linear in derivatives, so the difference
+ * is Cb * ((1 / kappa - 1) * derivative + psi) for each derivative, which is in PML along its axis.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template<uint8_t grid_type, bool usePrecomputedGrids>
+ICUDA_HOST
+void
+INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationCPML (TC pos, /**< position of point */
+                                                                                 TC posAbs, /**< absolute position of point */
+                                                                                 TCS diff11,
+                                                                                 TCS diff12,
+                                                                                 TCS diff21,
+                                                                                 TCS diff22,
+                                                                                 IGRID<TC> *grid,
+                                                                                 IGRID<TC> *oppositeGrid1,
+                                                                                 IGRID<TC> *oppositeGrid2,
+                                                                                 IGRID<TC> *psi1, /**< auxiliary grid for the first derivative */
+                                                                                 IGRID<TC> *psi2, /**< auxiliary grid for the second derivative */
+                                                                                 const CPMLProfile *profile1, /**< coefficients for the first derivative */
+                                                                                 const CPMLProfile *profile2, /**< coefficients for the second derivative */
+                                                                                 IGRID<TC> *Ca,
+                                                                                 IGRID<TC> *Cb,
+                                                                                 GridType gridType,
+                                                                                 IGRID<TC> *materialGrid,
+                                                                                 GridType materialGridType,
+                                                                                 FPValue materialModifier)
+{
+  bool isInPML1 = psi1 != NULLPTR && psi1->isStored (pos);
+  bool isInPML2 = psi2 != NULLPTR && psi2->isStored (pos);
+
+  if (!isInPML1 && !isInPML2)
+  {
+    return;
+  }
+
+  FieldValue prev11 = FIELDVALUE (0, 0);
+  FieldValue prev12 = FIELDVALUE (0, 0);
+  FieldValue prev21 = FIELDVALUE (0, 0);
+  FieldValue prev22 = FIELDVALUE (0, 0);
+
+  if (oppositeGrid1)
+  {
+    prev11 = *oppositeGrid1->getFieldValue (pos + diff11, 1);
+    prev12 = *oppositeGrid1->getFieldValue (pos + diff12, 1);
+  }
+
+  if (oppositeGrid2)
+  {
+    prev21 = *oppositeGrid2->getFieldValue (pos + diff21, 1);
+    prev22 = *oppositeGrid2->getFieldValue (pos + diff22, 1);
+  }
+
+  if (SOLVER_SETTINGS.getDoUseTFSF ())
+  {
+    calculateTFSF<grid_type> (posAbs, prev11, prev12, prev21, prev22, pos + diff11, pos + diff12, pos + diff21, pos + diff22);
+  }
+
+  GridCoordinate3D posAbs3D = expandTo3D (posAbs, ct1, ct2, ct3);
+
+  FieldValue diff = FIELDVALUE (0, 0);
+
+  if (isInPML1)
+  {
+    ASSERT (profile1 != NULLPTR);
+    grid_coord index = profile1->getIndex (posAbs3D);
+
+    FieldValue derivative = prev12 - prev11;
+    FieldValue psi = *psi1->getFieldValue (pos, 0) * profile1->getB (index) + derivative * profile1->getC (index);
+    psi1->setFieldValue (psi, pos, 0);
+
+    diff += derivative * (profile1->getKappaInv (index) - FPValue (1)) + psi;
+  }
+
+  if (isInPML2)
+  {
+    ASSERT (profile2 != NULLPTR);
+    grid_coord index = profile2->getIndex (posAbs3D);
+
+    FieldValue derivative = prev22 - prev21;
+    FieldValue psi = *psi2->getFieldValue (pos, 0) * profile2->getB (index) + derivative * profile2->getC (index);
+    psi2->setFieldValue (psi, pos, 0);
+
+    diff -= derivative * (profile2->getKappaInv (index) - FPValue (1)) + psi;
+  }
+
+  FieldValue valCa = FIELDVALUE (0, 0);
+  FieldValue valCb = FIELDVALUE (0, 0);
+
+  computeCaCb<usePrecomputedGrids> (valCa, valCb, pos, posAbs, Ca, Cb, false, gridType, materialGrid, materialGridType, materialModifier);
+
+  FieldValue val = *grid->getFieldValue (pos, 0);
+  grid->setFieldValue (val + diff * valCb, pos, 0);
+}
+#endif /* !GPU_INTERNAL_SCHEME */
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 template<uint8_t grid_type, bool usePrecomputedGrids>
 ICUDA_DEVICE
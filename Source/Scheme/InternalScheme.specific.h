@@ -77,8 +77,14 @@ InternalSchemeHelper::allocateGrids (InternalScheme<Type, TCoord, layout_type> *
   typedef TCoord<FPValue, false> TCSFP;
 
   /*
-   * Minimum number of stores steps is 2.
-   * TODO: optimize to be able to allocate single step for non-PML modes.
+   * Number of time layers, which are needed for each grid:
+   *   - E and H: only previous value of the same point is needed for update, so grids could be updated in place,
+   *     and a single time layer is allocated for them
+   *   - D and B (PML): current and previous values are needed for update of E and H, i.e. 2 layers
+   *   - D and B with metamaterials, D1 and B1: two previous values are needed for update of D1 and B1, i.e. 3 layers
+   *
+   * Number of stored time layers is the same for all of these grids, so that time layers are addressed in the same
+   * way for all of them (e.g. 1 is current after shift in time), but for E and H all of them share the same values.
    */
   int storedSteps = 2;
 
@@ -87,23 +93,274 @@ InternalSchemeHelper::allocateGrids (InternalScheme<Type, TCoord, layout_type> *
     storedSteps = 3;
   }
 
+  /*
+   * NTFF requires previous values of H, and CUDA copies grids to GPU and back time layer by time layer
+   */
+  bool doUpdateFieldsInPlace = !SOLVER_SETTINGS.getDoUseNTFF ()
+                               && !SOLVER_SETTINGS.getDoUseCuda ();
+
 #define GRID_NAME(x, y, steps, time_offset) \
   intScheme->x = intScheme->doNeed ## y ? new Grid<TC> (layout->get ## y ## Size (), steps, #x) : NULLPTR;
 #define GRID_NAME_NO_CHECK(x, y, steps, time_offset) \
   intScheme->x = new Grid<TC> (layout->get ## y ## Size (), steps, #x);
+#define GRID_NAME_FIELD(x, y, steps, time_offset) \
+  intScheme->x = intScheme->doNeed ## y ? new Grid<TC> (layout->get ## y ## Size (), steps, doUpdateFieldsInPlace, #x) : NULLPTR;
+#define GRID_NAME_PML(x, y, steps, time_offset) \
+  intScheme->x = intScheme->doNeed ## y ? allocatePMLGrid (intScheme, layout, layout->get ## y ## Size (), steps, #x) : NULLPTR;
+#define GRID_NAME_CPML(x, y, axis, steps, time_offset) \
+  intScheme->x = intScheme->doNeed ## y && intScheme->doNeedSigma ## axis \
+                 ? allocateCPMLGrid (intScheme, layout, layout->get ## y ## Size (), CoordinateType::axis, steps, #x) : NULLPTR;
 #include "Grids2.inc.h"
 #undef GRID_NAME
 #undef GRID_NAME_NO_CHECK
+#undef GRID_NAME_FIELD
+#undef GRID_NAME_PML
+#undef GRID_NAME_CPML
 }
 
+/**
+ * Allocate grid of auxiliary field of PML or of coefficients of its update.
+ *
+ * PML-free interior is computed without auxiliary fields (see Scheme::doUsePMLFreeInterior), so such grids are
+ * partial and store values only in PML slabs around it. Slabs are split in the same way as chunks, which are computed,
+ * so that each computed strip of chunk is inside one slab and its rows are contiguous.
+ *
+ * @return allocated grid
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+CUDA_HOST
+Grid< TCoord<grid_coord, true> > *
+InternalSchemeHelper::allocatePMLGrid (InternalScheme<Type, TCoord, layout_type> *intScheme,
+                                       YeeGridLayout<Type, TCoord, layout_type> *layout,
+                                       TCoord<grid_coord, true> size, /**< size of grid */
+                                       int storedSteps, /**< number of steps in time for which to store grid values */
+                                       const char *name) /**< name of grid */
+{
+  typedef TCoord<grid_coord, true> TC;
+
+  /*
+   * NOTE: should be in sync with Scheme::doUsePMLFreeInterior
+   */
+  if (!SOLVER_SETTINGS.getDoUsePML ()
+      || SOLVER_SETTINGS.getDoUseMetamaterials ()
+      || SOLVER_SETTINGS.getDoUseCuda ())
+  {
+    return new Grid<TC> (size, storedSteps, name);
+  }
+
+  std::vector<TC> slabStart;
+  std::vector<TC> slabEnd;
+
+  /*
+   * CPML doesn't use auxiliary fields and coefficients of split PML at all, so nothing is stored
+   * (see Scheme::doUseCPML)
+   */
+  if (!SOLVER_SETTINGS.getDoUseCPML ())
+  {
+    TC interiorStart;
+    TC interiorEnd;
+    getBorderStrips<TCoord> (size.getZero (), size, layout->getPMLFreeStart (), layout->getPMLFreeEnd (),
+                             slabStart, slabEnd, interiorStart, interiorEnd,
+                             intScheme->ct1, intScheme->ct2, intScheme->ct3);
+  }
+
+  return new Grid<TC> (size, storedSteps, slabStart, slabEnd, name);
+} /* InternalSchemeHelper::allocatePMLGrid */
+
+/**
+ * Allocate auxiliary grid of CPML for derivative along the specified axis.
+ *
+ * Convolution term of derivative is non-zero only in PML slabs along its axis, so grid is partial and stores values
+ * only in two slabs: before PML-free interior and after it along this axis.
+ *
+ * @return allocated grid
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+CUDA_HOST
+Grid< TCoord<grid_coord, true> > *
+InternalSchemeHelper::allocateCPMLGrid (InternalScheme<Type, TCoord, layout_type> *intScheme,
+                                        YeeGridLayout<Type, TCoord, layout_type> *layout,
+                                        TCoord<grid_coord, true> size, /**< size of grid */
+                                        CoordinateType axis, /**< axis of derivative */
+                                        int storedSteps, /**< number of steps in time for which to store grid values */
+                                        const char *name) /**< name of grid */
+{
+  typedef TCoord<grid_coord, true> TC;
+
+  CoordinateType ct1 = intScheme->ct1;
+  CoordinateType ct2 = intScheme->ct2;
+  CoordinateType ct3 = intScheme->ct3;
+
+  GridCoordinate3D size3D = expandTo3D (size, ct1, ct2, ct3);
+  grid_coord sizeAxis = CPMLProfile::getAxisCoordinate (size3D, axis);
+
+  grid_coord freeStart = CPMLProfile::getAxisCoordinate (expandTo3D (layout->getPMLFreeStart (), ct1, ct2, ct3), axis);
+  grid_coord freeEnd = CPMLProfile::getAxisCoordinate (expandTo3D (layout->getPMLFreeEnd (), ct1, ct2, ct3), axis);
+
+  freeStart = freeStart < sizeAxis ? freeStart : sizeAxis;
+  freeEnd = freeEnd < sizeAxis ? freeEnd : sizeAxis;
+  freeEnd = freeEnd > freeStart ? freeEnd : freeStart;
+
+  /*
+   * Slab before interior is [0, lowEnd), slab after interior is [highStart, size)
+   */
+  GridCoordinate3D lowEnd3D = size3D;
+  GridCoordinate3D highStart3D = size3D.getZero ();
+  switch (axis)
+  {
+    case CoordinateType::X:
+    {
+      lowEnd3D.set1 (freeStart);
+      highStart3D.set1 (freeEnd);
+      break;
+    }
+    case CoordinateType::Y:
+    {
+      lowEnd3D.set2 (freeStart);
+      highStart3D.set2 (freeEnd);
+      break;
+    }
+    case CoordinateType::Z:
+    {
+      lowEnd3D.set3 (freeStart);
+      highStart3D.set3 (freeEnd);
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  std::vector<TC> slabStart;
+  std::vector<TC> slabEnd;
+
+  slabStart.push_back (size.getZero ());
+  slabEnd.push_back (TC::initAxesCoordinate (lowEnd3D.get1 (), lowEnd3D.get2 (), lowEnd3D.get3 (), ct1, ct2, ct3));
+
+  slabStart.push_back (TC::initAxesCoordinate (highStart3D.get1 (), highStart3D.get2 (), highStart3D.get3 (), ct1, ct2, ct3));
+  slabEnd.push_back (size);
+
+  return new Grid<TC> (size, storedSteps, slabStart, slabEnd, name);
+} /* InternalSchemeHelper::allocateCPMLGrid */
+
+/**
+ * Split chunk [start, end) into strips, which cover all chunk except for the interior part [interiorStart, interiorEnd).
+ * Interior part is clamped to the chunk, so it might be empty, in which case strips cover all chunk.
+ * Clamped interior part is returned in [clampedStart, clampedEnd).
+ */
+template <template <typename, bool> class TCoord>
+CUDA_HOST
+void
+InternalSchemeHelper::getBorderStrips (TCoord<grid_coord, true> start, /**< start coordinate of chunk */
+                                       TCoord<grid_coord, true> end, /**< end coordinate of chunk */
+                                       TCoord<grid_coord, true> interiorStart, /**< start coordinate of interior part */
+                                       TCoord<grid_coord, true> interiorEnd, /**< end coordinate of interior part */
+                                       std::vector< TCoord<grid_coord, true> > &stripStart, /**< out: start coordinates of strips */
+                                       std::vector< TCoord<grid_coord, true> > &stripEnd, /**< out: end coordinates of strips */
+                                       TCoord<grid_coord, true> &clampedStart, /**< out: start coordinate of clamped interior */
+                                       TCoord<grid_coord, true> &clampedEnd, /**< out: end coordinate of clamped interior */
+                                       CoordinateType ct1, /**< coordinate type of the first axis */
+                                       CoordinateType ct2, /**< coordinate type of the second axis */
+                                       CoordinateType ct3) /**< coordinate type of the third axis */
+{
+  typedef TCoord<grid_coord, true> TC;
+
+  GridCoordinate3D start3D;
+  GridCoordinate3D end3D;
+  GridCoordinate3D interiorStart3D;
+  GridCoordinate3D interiorEnd3D;
+
+  expandTo3DStartEnd (start, end, start3D, end3D, ct1, ct2, ct3);
+  expandTo3DStartEnd (interiorStart, interiorEnd, interiorStart3D, interiorEnd3D, ct1, ct2, ct3);
+
+  grid_coord s[3] = { start3D.get1 (), start3D.get2 (), start3D.get3 () };
+  grid_coord e[3] = { end3D.get1 (), end3D.get2 (), end3D.get3 () };
+  grid_coord is[3] = { interiorStart3D.get1 (), interiorStart3D.get2 (), interiorStart3D.get3 () };
+  grid_coord ie[3] = { interiorEnd3D.get1 (), interiorEnd3D.get2 (), interiorEnd3D.get3 () };
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    is[axis] = is[axis] < s[axis] ? s[axis] : (is[axis] > e[axis] ? e[axis] : is[axis]);
+    ie[axis] = ie[axis] < is[axis] ? is[axis] : (ie[axis] > e[axis] ? e[axis] : ie[axis]);
+  }
+
+  clampedStart = TC::initAxesCoordinate (is[0], is[1], is[2], ct1, ct2, ct3);
+  clampedEnd = TC::initAxesCoordinate (ie[0], ie[1], ie[2], ct1, ct2, ct3);
+
+  /*
+   * Strips along each axis take all points along the next axes and only the interior points along the previous ones
+   */
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    grid_coord lowStart[3];
+    grid_coord lowEnd[3];
+    grid_coord highStart[3];
+    grid_coord highEnd[3];
+
+    for (int i = 0; i < 3; ++i)
+    {
+      if (i < axis)
+      {
+        lowStart[i] = highStart[i] = is[i];
+        lowEnd[i] = highEnd[i] = ie[i];
+      }
+      else if (i > axis)
+      {
+        lowStart[i] = highStart[i] = s[i];
+        lowEnd[i] = highEnd[i] = e[i];
+      }
+      else
+      {
+        lowStart[i] = s[i];
+        lowEnd[i] = is[i];
+        highStart[i] = ie[i];
+        highEnd[i] = e[i];
+      }
+    }
+
+    if (lowEnd[axis] > lowStart[axis])
+    {
+      stripStart.push_back (TC::initAxesCoordinate (lowStart[0], lowStart[1], lowStart[2], ct1, ct2, ct3));
+      stripEnd.push_back (TC::initAxesCoordinate (lowEnd[0], lowEnd[1], lowEnd[2], ct1, ct2, ct3));
+    }
+    if (highEnd[axis] > highStart[axis])
+    {
+      stripStart.push_back (TC::initAxesCoordinate (highStart[0], highStart[1], highStart[2], ct1, ct2, ct3));
+      stripEnd.push_back (TC::initAxesCoordinate (highEnd[0], highEnd[1], highEnd[2], ct1, ct2, ct3));
+    }
+  }
+} /* InternalSchemeHelper::getBorderStrips */
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 CUDA_HOST
 void
 InternalSchemeHelper::allocateGridsInc (InternalScheme<Type, TCoord, layout_type> *intScheme, YeeGridLayout<Type, TCoord, layout_type> *layout)
 {
-  // TODO: allocate considering number of time steps
-  intScheme->EInc = new Grid<GridCoordinate1D> (GRID_COORDINATE_1D (500*(layout->getSize ().get1 ()), CoordinateType::X), 2, "EInc");
-  intScheme->HInc = new Grid<GridCoordinate1D> (GRID_COORDINATE_1D (500*(layout->getSize ().get1 ()), CoordinateType::X), 2, "HInc");
+  typedef TCoord<grid_coord, true> TC;
+
+  /*
+   * Incident wave is read at TF/SF border only, i.e. at distances from zero coordinate of auxiliary grid, which are not
+   * greater than diagonal of TF/SF box plus offset of zero coordinate (2.5) plus offset of field components (less than
+   * 1 cell) plus 1 cell for interpolation.
+   */
+  TC diag = layout->getRightBorderTFSF () - layout->getLeftBorderTFSF ();
+  GridCoordinate3D diag3D = expandTo3D (diag, intScheme->ct1, intScheme->ct2, intScheme->ct3);
+  FPValue diagLength = sqrt ((FPValue) (SQR (diag3D.get1 ()) + SQR (diag3D.get2 ()) + SQR (diag3D.get3 ())));
+  grid_coord reach = (grid_coord) ceil (diagLength) + 5;
+
+  /*
+   * Wave in auxiliary grid moves by at most one cell per time step, so it never reaches the end of grid (and is never
+   * reflected from it) if there are more cells than time steps.
+   */
+  grid_coord size = (grid_coord) SOLVER_SETTINGS.getNumTimeSteps () + 2;
+  if (size < reach)
+  {
+    size = reach;
+  }
+
+  intScheme->EInc = new Grid<GridCoordinate1D> (GRID_COORDINATE_1D (size, CoordinateType::X), 2, "EInc");
+  intScheme->HInc = new Grid<GridCoordinate1D> (GRID_COORDINATE_1D (size, CoordinateType::X), 2, "HInc");
 }
 
 #ifdef PARALLEL_GRID
@@ -219,8 +476,8 @@ InternalSchemeHelperGPU::allocateGridsFromCPU (InternalSchemeGPU<Type, TCoord, l
   if (SOLVER_SETTINGS.getDoUseTFSF ())
   {
     GridCoordinate1D zero = GRID_COORDINATE_1D (0, CoordinateType::X);
-    intScheme->EInc = new CudaGrid<GridCoordinate1D> (GRID_COORDINATE_1D (500*(cpuScheme->yeeLayout->getSize ().get1 ()), CoordinateType::X), zero, cpuScheme->EInc);
-    intScheme->HInc = new CudaGrid<GridCoordinate1D> (GRID_COORDINATE_1D (500*(cpuScheme->yeeLayout->getSize ().get1 ()), CoordinateType::X), zero, cpuScheme->HInc);
+    intScheme->EInc = new CudaGrid<GridCoordinate1D> (cpuScheme->EInc->getSize (), zero, cpuScheme->EInc);
+    intScheme->HInc = new CudaGrid<GridCoordinate1D> (cpuScheme->HInc->getSize (), zero, cpuScheme->HInc);
   }
 }
 
@@ -329,8 +586,8 @@ InternalSchemeHelperGPU::copyGridsFromCPU (InternalSchemeGPU<Type, TCoord, layou
   if (SOLVER_SETTINGS.getDoUseTFSF ())
   {
     GridCoordinate1D zero = GRID_COORDINATE_1D (0, CoordinateType::X);
-    gpuScheme->EInc->copyFromCPU (zero, GRID_COORDINATE_1D (500*(gpuScheme->yeeLayout->getSize ().get1 ()), CoordinateType::X));
-    gpuScheme->HInc->copyFromCPU (zero, GRID_COORDINATE_1D (500*(gpuScheme->yeeLayout->getSize ().get1 ()), CoordinateType::X));
+    gpuScheme->EInc->copyFromCPU (zero, gpuScheme->EInc->getSize ());
+    gpuScheme->HInc->copyFromCPU (zero, gpuScheme->HInc->getSize ());
   }
 }
 
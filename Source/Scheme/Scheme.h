@@ -21,6 +21,9 @@
 #ifndef SCHEME_H
 #define SCHEME_H
 
+#include <map>
+#include <algorithm>
+
 #include "GridInterface.h"
 #include "PhysicsConst.h"
 #include "YeeGridLayout.h"
@@ -31,6 +34,16 @@
 
 class SchemeHelper;
 
+/**
+ * Part of computations of single time step for field
+ */
+ENUM_CLASS (FieldStepPart, uint8_t,
+  ALL, /**< all computations */
+  REGION, /**< only update of field values in the specified chunk */
+  FINALIZE /**< only computations, which are performed once after update of field values in all chunks
+            *   (border conditions and exact solution norms) */
+);
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 class Scheme
 {
@@ -60,6 +73,23 @@ protected:
 #ifdef PARALLEL_GRID
   ParallelGridGroup *eGroup;
   ParallelGridGroup *hGroup;
+
+  /**
+   * Flag whether to overlap share operations with computations in interior parts of grids
+   */
+  bool doOverlapShare;
+
+  /**
+   * Flag whether to share auxiliary grids (D, B, D1, B1), values in buffers of which are read only if buffers are
+   * wider than one cell
+   */
+  bool doShareAuxiliary;
+
+  /**
+   * Flags whether share operations for E and H grids are started, but not yet finished
+   */
+  bool isShareEPending;
+  bool isShareHPending;
 #endif /* PARALLEL_GRID */
 
 private:
@@ -99,6 +129,39 @@ private:
 
   YeeGridLayout<Type, TCoord, layout_type> *yeeLayout;
 
+  /**
+   * Classes of Ca and Cb coefficients of general FDTD update for each field (see --use-ca-cb-classes)
+   */
+  CaCbClasses *caCbClassesEx;
+  CaCbClasses *caCbClassesEy;
+  CaCbClasses *caCbClassesEz;
+  CaCbClasses *caCbClassesHx;
+  CaCbClasses *caCbClassesHy;
+  CaCbClasses *caCbClassesHz;
+
+  /**
+   * Coefficients of CPML for both derivatives in curl of each field, in the same order as terms of curl
+   * (see --use-cpml)
+   */
+  CPMLProfile *cpmlProfilesEx[2];
+  CPMLProfile *cpmlProfilesEy[2];
+  CPMLProfile *cpmlProfilesEz[2];
+  CPMLProfile *cpmlProfilesHx[2];
+  CPMLProfile *cpmlProfilesHy[2];
+  CPMLProfile *cpmlProfilesHz[2];
+
+  /**
+   * Flag whether fields are updated only in active region (see --use-active-region)
+   */
+  bool doTrackActiveRegion;
+
+  /**
+   * Active region [activeStart, activeEnd), i.e. bounding box of absolute positions of points of all fields, which
+   * might have non-zero values. Outside of it all fields are identically zero.
+   */
+  TC activeStart;
+  TC activeEnd;
+
 private:
 
   void performNSteps (time_step tStart, time_step N);
@@ -109,6 +172,18 @@ private:
   void tryShareH ();
   void shareE ();
   void shareH ();
+  void startShareE ();
+  void startShareH ();
+  void finishShareE ();
+  void finishShareH ();
+  void initShareTimeLayers ();
+
+  template <uint8_t grid_type>
+  void performFieldStepsInterior (time_step, TC, TC);
+  template <uint8_t grid_type>
+  void getComputationInterior (TC, TC, TC &, TC &);
+  template <uint8_t grid_type>
+  ParallelGridGroup *getGroup ();
 #endif /* PARALLEL_GRID */
 
   void rebalance ();
@@ -128,13 +203,51 @@ private:
 #endif
 
   template <uint8_t grid_type>
-  void performFieldSteps (time_step, TC, TC);
+  void performFieldSteps (time_step, TC, TC, bool);
+
+  template <uint8_t grid_type>
+  void calculateFieldStepPart (time_step, TC, TC, FieldStepPart);
+
+  template <uint8_t grid_type, bool usePML, bool useMetamaterials>
+  void calculateFieldStepRegion (time_step, TC, TC);
 
   template <uint8_t grid_type, bool usePML, bool useMetamaterials>
-  void calculateFieldStep (time_step, TC, TC);
+  void calculateFieldStep (time_step, TC, TC, FieldStepPart, bool);
+
+  template <uint8_t grid_type>
+  TC getTotalPositionDiff ();
+
+  bool doUsePMLFreeInterior () const;
+  bool isInPMLFreeInterior (TC) const;
+  bool doUseCPML () const;
+  bool isInPMLWithAuxiliaryFields (TC) const;
+
+  template <uint8_t grid_type>
+  void calculateFieldStepCPML (time_step, TC, TC);
+  template <uint8_t grid_type>
+  void initCPMLProfiles ();
+  template <uint8_t grid_type>
+  CPMLProfile **getCPMLProfiles ();
+
+  void getBorderStrips (TC, TC, TC, TC, std::vector<TC> &, std::vector<TC> &, TC &, TC &);
+
+  void initActiveRegion ();
+  void extendActiveRegion (TC, TC);
+  void extendActiveRegionByGrid (Grid<TC> *);
+  void growActiveRegion ();
+  void getActiveChunk (TC, TC, TC &, TC &);
+
+  template <uint8_t grid_type, bool usePML>
+  void getCaCbArgs (Grid<TC> **, GridType *, Grid<TC> **, GridType *, FPValue *);
+  template <uint8_t grid_type>
+  CaCbClasses *initCaCbClasses (TC, TC);
+  template <uint8_t grid_type>
+  CaCbClasses *getCaCbClasses ();
 
 private:
 
+  GridCoordinate1D getIncidentWaveEnd (time_step);
+
   void makeGridScattered (Grid<TC> *, GridType);
   void gatherFieldsTotal (bool);
   void saveGrids (time_step);
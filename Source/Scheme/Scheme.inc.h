@@ -116,19 +116,20 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
     if (SOLVER_SETTINGS.getDoUseTFSF ())
     {
       GridCoordinate1D zero1D = GRID_COORDINATE_1D (0, CoordinateType::X);
+      GridCoordinate1D end1D = getIncidentWaveEnd (t);
 
 #ifdef CUDA_ENABLED
       if (SOLVER_SETTINGS.getDoUseCuda ()
           && SOLVER_SETTINGS.getIndexOfGPUForCurrentNode () != NO_GPU)
       {
-        gpuIntSchemeOnGPU->performPlaneWaveEStepsKernelLaunch (d_gpuIntSchemeOnGPU, t, zero1D, gpuIntScheme->getEInc ()->getSize ());
+        gpuIntSchemeOnGPU->performPlaneWaveEStepsKernelLaunch (d_gpuIntSchemeOnGPU, t, zero1D, end1D);
         gpuIntSchemeOnGPU->shiftInTimePlaneWaveKernelLaunchEInc (d_gpuIntSchemeOnGPU);
         gpuIntScheme->getEInc ()->shiftInTime ();
       }
       else
 #endif /* CUDA_ENABLED */
       {
-        intScheme->performPlaneWaveESteps (t, zero1D, intScheme->getEInc ()->getSize ());
+        intScheme->performPlaneWaveESteps (t, zero1D, end1D);
         intScheme->getEInc ()->shiftInTime ();
       }
     }
@@ -143,19 +144,51 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
 #endif
     }
 
+    growActiveRegion ();
+
+    bool isInteriorComputedE = false;
+
+#ifdef PARALLEL_GRID
+    if (isShareHPending)
+    {
+      /*
+       * Share operations for H grids are still in progress, so compute interior parts of E grids first,
+       * and only then wait for share operations and compute border parts.
+       */
+      if (intScheme->getDoNeedEx ())
+      {
+        performFieldStepsInterior<static_cast<uint8_t> (GridType::EX)> (t, ExStart, ExEnd);
+      }
+
+      if (intScheme->getDoNeedEy ())
+      {
+        performFieldStepsInterior<static_cast<uint8_t> (GridType::EY)> (t, EyStart, EyEnd);
+      }
+
+      if (intScheme->getDoNeedEz ())
+      {
+        performFieldStepsInterior<static_cast<uint8_t> (GridType::EZ)> (t, EzStart, EzEnd);
+      }
+
+      finishShareH ();
+
+      isInteriorComputedE = true;
+    }
+#endif /* PARALLEL_GRID */
+
     if (intScheme->getDoNeedEx ())
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::EX)> (t, ExStart, ExEnd);
+      performFieldSteps<static_cast<uint8_t> (GridType::EX)> (t, ExStart, ExEnd, isInteriorComputedE);
     }
 
     if (intScheme->getDoNeedEy ())
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::EY)> (t, EyStart, EyEnd);
+      performFieldSteps<static_cast<uint8_t> (GridType::EY)> (t, EyStart, EyEnd, isInteriorComputedE);
     }
 
     if (intScheme->getDoNeedEz ())
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::EZ)> (t, EzStart, EzEnd);
+      performFieldSteps<static_cast<uint8_t> (GridType::EZ)> (t, EzStart, EzEnd, isInteriorComputedE);
     }
 
     if (useParallel && SOLVER_SETTINGS.getDoUseDynamicGrid ())
@@ -288,19 +321,20 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
     if (SOLVER_SETTINGS.getDoUseTFSF ())
     {
       GridCoordinate1D zero1D = GRID_COORDINATE_1D (0, CoordinateType::X);
+      GridCoordinate1D end1D = getIncidentWaveEnd (t);
 
 #ifdef CUDA_ENABLED
       if (SOLVER_SETTINGS.getDoUseCuda ()
           && SOLVER_SETTINGS.getIndexOfGPUForCurrentNode () != NO_GPU)
       {
-        gpuIntSchemeOnGPU->performPlaneWaveHStepsKernelLaunch (d_gpuIntSchemeOnGPU, t, zero1D, gpuIntScheme->getHInc ()->getSize ());
+        gpuIntSchemeOnGPU->performPlaneWaveHStepsKernelLaunch (d_gpuIntSchemeOnGPU, t, zero1D, end1D);
         gpuIntSchemeOnGPU->shiftInTimePlaneWaveKernelLaunchHInc (d_gpuIntSchemeOnGPU);
         gpuIntScheme->getHInc ()->shiftInTime ();
       }
       else
 #endif /* CUDA_ENABLED */
       {
-        intScheme->performPlaneWaveHSteps (t, zero1D, intScheme->getHInc ()->getSize ());
+        intScheme->performPlaneWaveHSteps (t, zero1D, end1D);
         intScheme->getHInc ()->shiftInTime ();
       }
     }
@@ -315,19 +349,51 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
 #endif
     }
 
+    growActiveRegion ();
+
+    bool isInteriorComputedH = false;
+
+#ifdef PARALLEL_GRID
+    if (isShareEPending)
+    {
+      /*
+       * Share operations for E grids are still in progress, so compute interior parts of H grids first,
+       * and only then wait for share operations and compute border parts.
+       */
+      if (intScheme->getDoNeedHx ())
+      {
+        performFieldStepsInterior<static_cast<uint8_t> (GridType::HX)> (t, HxStart, HxEnd);
+      }
+
+      if (intScheme->getDoNeedHy ())
+      {
+        performFieldStepsInterior<static_cast<uint8_t> (GridType::HY)> (t, HyStart, HyEnd);
+      }
+
+      if (intScheme->getDoNeedHz ())
+      {
+        performFieldStepsInterior<static_cast<uint8_t> (GridType::HZ)> (t, HzStart, HzEnd);
+      }
+
+      finishShareE ();
+
+      isInteriorComputedH = true;
+    }
+#endif /* PARALLEL_GRID */
+
     if (intScheme->getDoNeedHx ())
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::HX)> (t, HxStart, HxEnd);
+      performFieldSteps<static_cast<uint8_t> (GridType::HX)> (t, HxStart, HxEnd, isInteriorComputedH);
     }
 
     if (intScheme->getDoNeedHy ())
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::HY)> (t, HyStart, HyEnd);
+      performFieldSteps<static_cast<uint8_t> (GridType::HY)> (t, HyStart, HyEnd, isInteriorComputedH);
     }
 
     if (intScheme->getDoNeedHz ())
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::HZ)> (t, HzStart, HzEnd);
+      performFieldSteps<static_cast<uint8_t> (GridType::HZ)> (t, HzStart, HzEnd, isInteriorComputedH);
     }
 
     if (useParallel && SOLVER_SETTINGS.getDoUseDynamicGrid ())
@@ -458,6 +524,13 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
 #endif /* PARALLEL_GRID */
   }
 
+#ifdef PARALLEL_GRID
+  /*
+   * Grids should be fully updated after the last time step
+   */
+  finishShareH ();
+#endif /* PARALLEL_GRID */
+
 #ifdef CUDA_ENABLED
   if (SOLVER_SETTINGS.getDoUseCuda ()
       && SOLVER_SETTINGS.getIndexOfGPUForCurrentNode () != NO_GPU)
@@ -491,7 +564,12 @@ Scheme<Type, TCoord, layout_type>::tryShareE ()
   {
     ASSERT (eGroup->getShareStep () == NTimeSteps);
 
-    shareE ();
+    startShareE ();
+
+    if (!doOverlapShare)
+    {
+      finishShareE ();
+    }
   }
 }
 
@@ -513,7 +591,12 @@ Scheme<Type, TCoord, layout_type>::tryShareH ()
   {
     ASSERT (hGroup->getShareStep () == NTimeSteps);
 
-    shareH ();
+    startShareH ();
+
+    if (!doOverlapShare)
+    {
+      finishShareH ();
+    }
   }
 }
 
@@ -523,109 +606,232 @@ Scheme<Type, TCoord, layout_type>::tryShareH ()
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 void
 Scheme<Type, TCoord, layout_type>::shareE ()
+{
+  startShareE ();
+  finishShareE ();
+}
+
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::shareH ()
+{
+  startShareH ();
+  finishShareH ();
+}
+
+/**
+ * Start share operations, required for grids. Values of all grids of group are sent to each neighbor at once.
+ * Share operations should be finished by finishShareE/finishShareH before values in buffers of grids are used.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::startShareE ()
 {
   if (!useParallel)
   {
     return;
   }
 
+  ASSERT (!isShareEPending);
+
+  std::vector<ParallelGrid *> grids;
+
   if (intScheme->getDoNeedEx ())
   {
-    ((ParallelGrid *) intScheme->getEx ())->share ();
+    grids.push_back ((ParallelGrid *) intScheme->getEx ());
 
-    if (SOLVER_SETTINGS.getDoUsePML ())
+    if (SOLVER_SETTINGS.getDoUsePML ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getDx ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getDx ());
     }
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    if (SOLVER_SETTINGS.getDoUseMetamaterials ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getD1x ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getD1x ());
     }
   }
 
   if (intScheme->getDoNeedEy ())
   {
-    ((ParallelGrid *) intScheme->getEy ())->share ();
+    grids.push_back ((ParallelGrid *) intScheme->getEy ());
 
-    if (SOLVER_SETTINGS.getDoUsePML ())
+    if (SOLVER_SETTINGS.getDoUsePML ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getDy ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getDy ());
     }
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    if (SOLVER_SETTINGS.getDoUseMetamaterials ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getD1y ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getD1y ());
     }
   }
 
   if (intScheme->getDoNeedEz ())
   {
-    ((ParallelGrid *) intScheme->getEz ())->share ();
+    grids.push_back ((ParallelGrid *) intScheme->getEz ());
 
-    if (SOLVER_SETTINGS.getDoUsePML ())
+    if (SOLVER_SETTINGS.getDoUsePML ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getDz ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getDz ());
     }
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    if (SOLVER_SETTINGS.getDoUseMetamaterials ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getD1z ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getD1z ());
     }
   }
 
+  eGroup->startShare (grids);
   eGroup->zeroShareStep ();
+
+  isShareEPending = true;
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 void
-Scheme<Type, TCoord, layout_type>::shareH ()
+Scheme<Type, TCoord, layout_type>::startShareH ()
 {
   if (!useParallel)
   {
     return;
   }
 
+  ASSERT (!isShareHPending);
+
+  std::vector<ParallelGrid *> grids;
+
   if (intScheme->getDoNeedHx ())
   {
-    ((ParallelGrid *) intScheme->getHx ())->share ();
+    grids.push_back ((ParallelGrid *) intScheme->getHx ());
 
-    if (SOLVER_SETTINGS.getDoUsePML ())
+    if (SOLVER_SETTINGS.getDoUsePML ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getBx ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getBx ());
     }
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    if (SOLVER_SETTINGS.getDoUseMetamaterials ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getB1x ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getB1x ());
     }
   }
 
   if (intScheme->getDoNeedHy ())
   {
-    ((ParallelGrid *) intScheme->getHy ())->share ();
+    grids.push_back ((ParallelGrid *) intScheme->getHy ());
 
-    if (SOLVER_SETTINGS.getDoUsePML ())
+    if (SOLVER_SETTINGS.getDoUsePML ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getBy ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getBy ());
     }
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    if (SOLVER_SETTINGS.getDoUseMetamaterials ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getB1y ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getB1y ());
     }
   }
 
   if (intScheme->getDoNeedHz ())
   {
-    ((ParallelGrid *) intScheme->getHz ())->share ();
+    grids.push_back ((ParallelGrid *) intScheme->getHz ());
 
-    if (SOLVER_SETTINGS.getDoUsePML ())
+    if (SOLVER_SETTINGS.getDoUsePML ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getBz ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getBz ());
     }
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    if (SOLVER_SETTINGS.getDoUseMetamaterials ()
+        && doShareAuxiliary)
     {
-      ((ParallelGrid *) intScheme->getB1z ())->share ();
+      grids.push_back ((ParallelGrid *) intScheme->getB1z ());
     }
   }
 
+  hGroup->startShare (grids);
   hGroup->zeroShareStep ();
+
+  isShareHPending = true;
+}
+
+/**
+ * Setup time layers of grids, which are sent by share operations.
+ *
+ * Share operations are performed right after shift in time, when time layer 0 contains the oldest values, which are
+ * always overwritten before they are read, so it is never sent. If buffers are one cell wide, values in them are never
+ * computed locally and are only read by update of the opposite field at the current time layer 1. Thus, only this
+ * layer of E and H is sent, and auxiliary grids are not sent at all. Wider buffers are partially computed locally,
+ * which requires all previous time layers of all grids.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::initShareTimeLayers ()
+{
+  doShareAuxiliary = SOLVER_SETTINGS.getBufferSize () > 1;
+
+#define SETUP_SHARE_TIME_LAYERS(x) \
+  if (intScheme->has ## x ()) \
+  { \
+    ParallelGrid *grid = (ParallelGrid *) intScheme->get ## x (); \
+    grid->setShareTimeLayers (1, doShareAuxiliary ? grid->getCountStoredSteps () : 2); \
+  }
+
+  SETUP_SHARE_TIME_LAYERS (Ex)
+  SETUP_SHARE_TIME_LAYERS (Ey)
+  SETUP_SHARE_TIME_LAYERS (Ez)
+  SETUP_SHARE_TIME_LAYERS (Hx)
+  SETUP_SHARE_TIME_LAYERS (Hy)
+  SETUP_SHARE_TIME_LAYERS (Hz)
+
+  SETUP_SHARE_TIME_LAYERS (Dx)
+  SETUP_SHARE_TIME_LAYERS (Dy)
+  SETUP_SHARE_TIME_LAYERS (Dz)
+  SETUP_SHARE_TIME_LAYERS (Bx)
+  SETUP_SHARE_TIME_LAYERS (By)
+  SETUP_SHARE_TIME_LAYERS (Bz)
+
+  SETUP_SHARE_TIME_LAYERS (D1x)
+  SETUP_SHARE_TIME_LAYERS (D1y)
+  SETUP_SHARE_TIME_LAYERS (D1z)
+  SETUP_SHARE_TIME_LAYERS (B1x)
+  SETUP_SHARE_TIME_LAYERS (B1y)
+  SETUP_SHARE_TIME_LAYERS (B1z)
+
+#undef SETUP_SHARE_TIME_LAYERS
+}
+
+/**
+ * Finish share operations, started by startShareE/startShareH
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::finishShareE ()
+{
+  if (!isShareEPending)
+  {
+    return;
+  }
+
+  eGroup->finishShare ();
+
+  isShareEPending = false;
+}
+
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::finishShareH ()
+{
+  if (!isShareHPending)
+  {
+    return;
+  }
+
+  hGroup->finishShare ();
+
+  isShareHPending = false;
 }
 #endif /* PARALLEL_GRID */
 
@@ -787,62 +993,1224 @@ template <uint8_t grid_type>
 void
 Scheme<Type, TCoord, layout_type>::performFieldSteps (time_step t, /**< time step to compute */
                                                       TC Start, /**< start coordinate of chunk to compute */
-                                                      TC End) /**< end coordinate of chunk to compute */
+                                                      TC End, /**< end coordinate of chunk to compute */
+                                                      bool isInteriorComputed) /**< flag whether interior part of chunk
+                                                                                *   is already computed by
+                                                                                *   performFieldStepsInterior */
 {
-  if (SOLVER_SETTINGS.getDoUsePML ())
+  if (isInteriorComputed)
   {
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+#ifdef PARALLEL_GRID
+    TC interiorStart;
+    TC interiorEnd;
+    getComputationInterior<grid_type> (Start, End, interiorStart, interiorEnd);
+
+    std::vector<TC> stripStart;
+    std::vector<TC> stripEnd;
+    getBorderStrips (Start, End, interiorStart, interiorEnd, stripStart, stripEnd, interiorStart, interiorEnd);
+
+    for (size_t i = 0; i < stripStart.size (); ++i)
     {
-      calculateFieldStep<grid_type, true, true> (t, Start, End);
+      calculateFieldStepPart<grid_type> (t, stripStart[i], stripEnd[i], FieldStepPart::REGION);
     }
-    else
+
+    calculateFieldStepPart<grid_type> (t, Start, End, FieldStepPart::FINALIZE);
+#else /* PARALLEL_GRID */
+    UNREACHABLE;
+#endif /* !PARALLEL_GRID */
+  }
+  else if (doTrackActiveRegion)
+  {
+    /*
+     * Values outside of active region are zero and remain zero after update, so only finalization is performed
+     * for the whole chunk
+     */
+    TC activeChunkStart;
+    TC activeChunkEnd;
+    getActiveChunk (Start, End, activeChunkStart, activeChunkEnd);
+
+    if (activeChunkStart < activeChunkEnd)
     {
-      calculateFieldStep<grid_type, true, false> (t, Start, End);
+      calculateFieldStepPart<grid_type> (t, activeChunkStart, activeChunkEnd, FieldStepPart::REGION);
     }
+
+    calculateFieldStepPart<grid_type> (t, Start, End, FieldStepPart::FINALIZE);
   }
   else
   {
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    calculateFieldStepPart<grid_type> (t, Start, End, FieldStepPart::ALL);
+  }
+
+  bool doUsePointSource;
+  switch (grid_type)
+  {
+    case (static_cast<uint8_t> (GridType::EX)):
+    {
+      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceEx ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::EY)):
+    {
+      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceEy ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::EZ)):
+    {
+      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceEz ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HX)):
+    {
+      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceHx ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HY)):
+    {
+      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceHy ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HZ)):
+    {
+      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceHz ();
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  if (doUsePointSource)
+  {
+#ifdef CUDA_ENABLED
+    if (SOLVER_SETTINGS.getDoUseCuda ()
+        && SOLVER_SETTINGS.getIndexOfGPUForCurrentNode () != NO_GPU)
+    {
+      gpuIntSchemeOnGPU->template performPointSourceCalcKernelLaunch<grid_type> (d_gpuIntSchemeOnGPU, t);
+    }
+    else
+#endif /* CUDA_ENABLED */
+    {
+      intScheme->template performPointSourceCalc<grid_type> (t);
+    }
+  }
+}
+
+/**
+ * Perform part of computations of single time step for specific field and for specified chunk.
+ *
+ * Chunk is split into PML slabs and PML-free interior, each of which is computed with its own specialization
+ * of kernels. Interior doesn't need auxiliary D/B fields, so they are updated only in PML slabs. In CPML mode
+ * PML slabs are computed as interior, and then terms of CPML are added to them.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::calculateFieldStepPart (time_step t, /**< time step to compute */
+                                                           TC Start, /**< start coordinate of chunk to compute */
+                                                           TC End, /**< end coordinate of chunk to compute */
+                                                           FieldStepPart part) /**< part of computations to perform */
+{
+  if (part != FieldStepPart::FINALIZE)
+  {
+    if (doUsePMLFreeInterior ())
+    {
+      TC diff = getTotalPositionDiff<grid_type> ();
+
+      std::vector<TC> stripStart;
+      std::vector<TC> stripEnd;
+      TC interiorStart;
+      TC interiorEnd;
+      getBorderStrips (Start + diff, End + diff, yeeLayout->getPMLFreeStart (), yeeLayout->getPMLFreeEnd (),
+                       stripStart, stripEnd, interiorStart, interiorEnd);
+
+      for (size_t i = 0; i < stripStart.size (); ++i)
+      {
+        if (doUseCPML ())
+        {
+          calculateFieldStepRegion<grid_type, false, false> (t, stripStart[i] - diff, stripEnd[i] - diff);
+          calculateFieldStepCPML<grid_type> (t, stripStart[i] - diff, stripEnd[i] - diff);
+        }
+        else
+        {
+          calculateFieldStepRegion<grid_type, true, false> (t, stripStart[i] - diff, stripEnd[i] - diff);
+        }
+      }
+
+      if (interiorStart < interiorEnd)
+      {
+        calculateFieldStepRegion<grid_type, false, false> (t, interiorStart - diff, interiorEnd - diff);
+      }
+    }
+    else if (SOLVER_SETTINGS.getDoUsePML ())
+    {
+      if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+      {
+        calculateFieldStepRegion<grid_type, true, true> (t, Start, End);
+      }
+      else
+      {
+        calculateFieldStepRegion<grid_type, true, false> (t, Start, End);
+      }
+    }
+    else
+    {
+      if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+      {
+        calculateFieldStepRegion<grid_type, false, true> (t, Start, End);
+      }
+      else
+      {
+        calculateFieldStepRegion<grid_type, false, false> (t, Start, End);
+      }
+    }
+  }
+
+  if (part != FieldStepPart::REGION)
+  {
+    if (SOLVER_SETTINGS.getDoUsePML ()
+        && !doUseCPML ())
     {
-      calculateFieldStep<grid_type, false, true> (t, Start, End);
+      if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+      {
+        calculateFieldStep<grid_type, true, true> (t, Start, End, FieldStepPart::FINALIZE, false);
+      }
+      else
+      {
+        calculateFieldStep<grid_type, true, false> (t, Start, End, FieldStepPart::FINALIZE, false);
+      }
     }
     else
     {
-      calculateFieldStep<grid_type, false, false> (t, Start, End);
+      if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+      {
+        calculateFieldStep<grid_type, false, true> (t, Start, End, FieldStepPart::FINALIZE, false);
+      }
+      else
+      {
+        calculateFieldStep<grid_type, false, false> (t, Start, End, FieldStepPart::FINALIZE, false);
+      }
     }
   }
+}
+
+/**
+ * Update field values in the specified chunk, all points of which either are in PML or are not in PML.
+ *
+ * Chunk is split into TF/SF shell and the rest, only the shell is computed with TF/SF update, while the rest is
+ * computed with row kernels.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type, bool usePML, bool useMetamaterials>
+void
+Scheme<Type, TCoord, layout_type>::calculateFieldStepRegion (time_step t, /**< time step to compute */
+                                                             TC start, /**< start coordinate of chunk to compute */
+                                                             TC end) /**< end coordinate of chunk to compute */
+{
+  if (!SOLVER_SETTINGS.getDoUseTFSF ()
+      || SOLVER_SETTINGS.getDoUseCuda ())
+  {
+    calculateFieldStep<grid_type, usePML, useMetamaterials> (t, start, end, FieldStepPart::REGION,
+                                                             SOLVER_SETTINGS.getDoUseTFSF ());
+    return;
+  }
+
+  TC diff = getTotalPositionDiff<grid_type> ();
+
+  /*
+   * Points outside of outer box of shell
+   */
+  std::vector<TC> outerStripStart;
+  std::vector<TC> outerStripEnd;
+  TC outerStart;
+  TC outerEnd;
+  getBorderStrips (start + diff, end + diff, yeeLayout->getTFSFShellOuterStart (), yeeLayout->getTFSFShellOuterEnd (),
+                   outerStripStart, outerStripEnd, outerStart, outerEnd);
+
+  for (size_t i = 0; i < outerStripStart.size (); ++i)
+  {
+    calculateFieldStep<grid_type, usePML, useMetamaterials> (t, outerStripStart[i] - diff, outerStripEnd[i] - diff,
+                                                             FieldStepPart::REGION, false);
+  }
+
+  if (!(outerStart < outerEnd))
+  {
+    return;
+  }
+
+  /*
+   * Shell itself and points inside of inner box of shell
+   */
+  std::vector<TC> shellStart;
+  std::vector<TC> shellEnd;
+  TC innerStart;
+  TC innerEnd;
+  getBorderStrips (outerStart, outerEnd, yeeLayout->getTFSFShellInnerStart (), yeeLayout->getTFSFShellInnerEnd (),
+                   shellStart, shellEnd, innerStart, innerEnd);
+
+  for (size_t i = 0; i < shellStart.size (); ++i)
+  {
+    calculateFieldStep<grid_type, usePML, useMetamaterials> (t, shellStart[i] - diff, shellEnd[i] - diff,
+                                                             FieldStepPart::REGION, true);
+  }
+
+  if (innerStart < innerEnd)
+  {
+    calculateFieldStep<grid_type, usePML, useMetamaterials> (t, innerStart - diff, innerEnd - diff,
+                                                             FieldStepPart::REGION, false);
+  }
+}
+
+/**
+ * Check whether PML-free interior is computed without PML (and without auxiliary D/B fields). This is possible only
+ * when metamaterials, which need auxiliary fields in all grid, are not used.
+ *
+ * @return true, if PML-free interior is computed without PML
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+bool
+Scheme<Type, TCoord, layout_type>::doUsePMLFreeInterior () const
+{
+  return SOLVER_SETTINGS.getDoUsePML ()
+         && !SOLVER_SETTINGS.getDoUseMetamaterials ()
+         && !SOLVER_SETTINGS.getDoUseCuda ();
+}
+
+/**
+ * Check whether point is in PML-free interior, which is computed without PML
+ *
+ * @return true, if point is in PML-free interior
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+bool
+Scheme<Type, TCoord, layout_type>::isInPMLFreeInterior (TC posAbs) const /**< absolute position of point */
+{
+  return doUsePMLFreeInterior ()
+         && posAbs >= yeeLayout->getPMLFreeStart ()
+         && posAbs < yeeLayout->getPMLFreeEnd ();
+}
+
+/**
+ * Check whether CPML is used instead of PML with auxiliary D/B fields. CPML is used only in PML slabs around
+ * PML-free interior (see doUsePMLFreeInterior).
+ *
+ * NOTE: should be in sync with InternalSchemeHelper::allocatePMLGrid
+ *
+ * @return true, if CPML is used
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+bool
+Scheme<Type, TCoord, layout_type>::doUseCPML () const
+{
+  return doUsePMLFreeInterior ()
+         && SOLVER_SETTINGS.getDoUseCPML ();
+}
+
+/**
+ * Check whether point is updated with auxiliary D/B fields of PML
+ *
+ * @return true, if point is updated with auxiliary fields
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+bool
+Scheme<Type, TCoord, layout_type>::isInPMLWithAuxiliaryFields (TC posAbs) const /**< absolute position of point */
+{
+  return SOLVER_SETTINGS.getDoUsePML ()
+         && !doUseCPML ()
+         && !isInPMLFreeInterior (posAbs);
+}
+
+/**
+ * Add terms of CPML to field values in the specified chunk, which are already updated without PML, and update
+ * auxiliary convolution grids of CPML.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::calculateFieldStepCPML (time_step t, /**< time step to compute */
+                                                           TC start, /**< start coordinate of chunk to compute */
+                                                           TC end) /**< end coordinate of chunk to compute */
+{
+  ASSERT (doUseCPML ());
+
+  Grid<TC> *grid = NULLPTR;
+  GridType gridType = GridType::NONE;
+
+  Grid<TC> *materialGrid = NULLPTR;
+  GridType materialGridType = GridType::NONE;
+
+  Grid<TC> *materialGrid1 = NULLPTR;
+  GridType materialGridType1 = GridType::NONE;
+
+  Grid<TC> *materialGrid2 = NULLPTR;
+  GridType materialGridType2 = GridType::NONE;
+
+  Grid<TC> *materialGrid3 = NULLPTR;
+  GridType materialGridType3 = GridType::NONE;
+
+  Grid<TC> *materialGrid4 = NULLPTR;
+  GridType materialGridType4 = GridType::NONE;
+
+  Grid<TC> *materialGrid5 = NULLPTR;
+  GridType materialGridType5 = GridType::NONE;
+
+  Grid<TC> *oppositeGrid1 = NULLPTR;
+  Grid<TC> *oppositeGrid2 = NULLPTR;
+
+  Grid<TC> *gridPML1 = NULLPTR;
+  GridType gridPMLType1 = GridType::NONE;
+
+  Grid<TC> *gridPML2 = NULLPTR;
+  GridType gridPMLType2 = GridType::NONE;
+
+  Grid<TC> *Ca = NULLPTR;
+  Grid<TC> *Cb = NULLPTR;
+
+  Grid<TC> *CB0 = NULLPTR;
+  Grid<TC> *CB1 = NULLPTR;
+  Grid<TC> *CB2 = NULLPTR;
+  Grid<TC> *CA1 = NULLPTR;
+  Grid<TC> *CA2 = NULLPTR;
+
+  Grid<TC> *CaPML = NULLPTR;
+  Grid<TC> *CbPML = NULLPTR;
+  Grid<TC> *CcPML = NULLPTR;
+
+  SourceCallBack rightSideFunc = NULLPTR;
+  SourceCallBack borderFunc = NULLPTR;
+  SourceCallBack exactFunc = NULLPTR;
+
+  TCS diff11;
+  TCS diff12;
+  TCS diff21;
+  TCS diff22;
+
+  FPValue materialModifier;
+
+  intScheme->template calculateFieldStepInit<grid_type, false, false> (&grid, &gridType,
+    &materialGrid, &materialGridType, &materialGrid1, &materialGridType1, &materialGrid2, &materialGridType2,
+    &materialGrid3, &materialGridType3, &materialGrid4, &materialGridType4, &materialGrid5, &materialGridType5,
+    &oppositeGrid1, &oppositeGrid2, &gridPML1, &gridPMLType1, &gridPML2, &gridPMLType2,
+    &rightSideFunc, &borderFunc, &exactFunc, &materialModifier, &Ca, &Cb,
+    &CB0, &CB1, &CB2, &CA1, &CA2, &CaPML, &CbPML, &CcPML);
+
+  intScheme->template calculateFieldStepInitDiff<grid_type> (&diff11, &diff12, &diff21, &diff22);
+
+  Grid<TC> *psi1 = NULLPTR;
+  Grid<TC> *psi2 = NULLPTR;
+  intScheme->template calculateFieldStepInitCPML<grid_type> (&psi1, &psi2);
+
+  CPMLProfile **profiles = getCPMLProfiles<grid_type> ();
+
+  grid_coord count = (end - start).calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+  for (grid_coord index = 0; index < count; ++index)
+  {
+    TC pos = VectorFieldValues<TC>::getPosition (start, end, index);
+    TC posAbs = grid->getTotalPosition (pos);
+
+    if (SOLVER_SETTINGS.getDoUseCaCbGrids ())
+    {
+      intScheme->template calculateFieldStepIterationCPML<grid_type, true> (pos, posAbs, diff11, diff12, diff21, diff22,
+                                                                            grid, oppositeGrid1, oppositeGrid2,
+                                                                            psi1, psi2, profiles[0], profiles[1], Ca, Cb,
+                                                                            gridType, materialGrid, materialGridType,
+                                                                            materialModifier);
+    }
+    else
+    {
+      intScheme->template calculateFieldStepIterationCPML<grid_type, false> (pos, posAbs, diff11, diff12, diff21, diff22,
+                                                                             grid, oppositeGrid1, oppositeGrid2,
+                                                                             psi1, psi2, profiles[0], profiles[1], Ca, Cb,
+                                                                             gridType, materialGrid, materialGridType,
+                                                                             materialModifier);
+    }
+  }
+}
+
+/**
+ * Initialize coefficients of CPML for both derivatives in curl of specific field (see SchemeHelper::initCPML).
+ * Coefficients depend on depth of point in PML along axis of derivative, which is measured from border of PML
+ * to real coordinate of field point.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::initCPMLProfiles ()
+{
+  Grid<TC> *grid = NULLPTR;
+  Grid<TC> *psi[2] = { NULLPTR, NULLPTR };
+  CoordinateType axis[2] = { CoordinateType::NONE, CoordinateType::NONE };
+
+  switch (grid_type)
+  {
+    case (static_cast<uint8_t> (GridType::EX)):
+    {
+      grid = intScheme->getEx ();
+      axis[0] = CoordinateType::Y;
+      axis[1] = CoordinateType::Z;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::EY)):
+    {
+      grid = intScheme->getEy ();
+      axis[0] = CoordinateType::Z;
+      axis[1] = CoordinateType::X;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::EZ)):
+    {
+      grid = intScheme->getEz ();
+      axis[0] = CoordinateType::X;
+      axis[1] = CoordinateType::Y;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HX)):
+    {
+      grid = intScheme->getHx ();
+      axis[0] = CoordinateType::Z;
+      axis[1] = CoordinateType::Y;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HY)):
+    {
+      grid = intScheme->getHy ();
+      axis[0] = CoordinateType::X;
+      axis[1] = CoordinateType::Z;
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HZ)):
+    {
+      grid = intScheme->getHz ();
+      axis[0] = CoordinateType::Y;
+      axis[1] = CoordinateType::X;
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  intScheme->template calculateFieldStepInitCPML<grid_type> (&psi[0], &psi[1]);
+
+  CPMLProfile **profiles = getCPMLProfiles<grid_type> ();
+
+  GridCoordinate3D size3D = expandTo3D (grid->getTotalSize (), ct1, ct2, ct3);
+  GridCoordinateFP3D leftBorder3D = expandTo3D (convertCoord (yeeLayout->getLeftBorderPML ())
+                                                + yeeLayout->getZeroCoordFP (), ct1, ct2, ct3);
+  GridCoordinateFP3D rightBorder3D = expandTo3D (convertCoord (yeeLayout->getRightBorderPML ())
+                                                 + yeeLayout->getZeroCoordFP (), ct1, ct2, ct3);
+  GridCoordinate3D sizePML3D = expandTo3D (yeeLayout->getLeftBorderPML (), ct1, ct2, ct3);
+
+  for (int k = 0; k < 2; ++k)
+  {
+    /*
+     * Derivative is not computed in this scheme
+     */
+    if (psi[k] == NULLPTR)
+    {
+      continue;
+    }
+
+    grid_coord size = CPMLProfile::getAxisCoordinate (size3D, axis[k]);
+    FPValue leftBorder = CPMLProfile::getAxisCoordinate (leftBorder3D, axis[k]);
+    FPValue rightBorder = CPMLProfile::getAxisCoordinate (rightBorder3D, axis[k]);
+    FPValue boundary = FPValue (CPMLProfile::getAxisCoordinate (sizePML3D, axis[k]));
+
+    profiles[k] = new CPMLProfile (axis[k], size);
+
+    for (grid_coord i = 0; i < size; ++i)
+    {
+      TC posAbs = TC::initAxesCoordinate (axis[k] == CoordinateType::X ? i : 0,
+                                          axis[k] == CoordinateType::Y ? i : 0,
+                                          axis[k] == CoordinateType::Z ? i : 0,
+                                          ct1, ct2, ct3);
+
+      TCFP coordFP;
+      switch (grid_type)
+      {
+        case (static_cast<uint8_t> (GridType::EX)):
+        {
+          coordFP = yeeLayout->getExCoordFP (posAbs);
+          break;
+        }
+        case (static_cast<uint8_t> (GridType::EY)):
+        {
+          coordFP = yeeLayout->getEyCoordFP (posAbs);
+          break;
+        }
+        case (static_cast<uint8_t> (GridType::EZ)):
+        {
+          coordFP = yeeLayout->getEzCoordFP (posAbs);
+          break;
+        }
+        case (static_cast<uint8_t> (GridType::HX)):
+        {
+          coordFP = yeeLayout->getHxCoordFP (posAbs);
+          break;
+        }
+        case (static_cast<uint8_t> (GridType::HY)):
+        {
+          coordFP = yeeLayout->getHyCoordFP (posAbs);
+          break;
+        }
+        case (static_cast<uint8_t> (GridType::HZ)):
+        {
+          coordFP = yeeLayout->getHzCoordFP (posAbs);
+          break;
+        }
+        default:
+        {
+          UNREACHABLE;
+        }
+      }
+
+      FPValue coord = CPMLProfile::getAxisCoordinate (expandTo3D (coordFP, ct1, ct2, ct3), axis[k]);
+
+      FPValue dist = FPValue (0);
+      if (coord < leftBorder)
+      {
+        dist = leftBorder - coord;
+      }
+      else if (coord > rightBorder)
+      {
+        dist = coord - rightBorder;
+      }
+
+      /*
+       * Points outside of PML keep default coefficients, with which convolution term is always zero
+       */
+      if (dist > FPValue (0))
+      {
+        FPValue b;
+        FPValue c;
+        FPValue kappaInv;
+        SchemeHelper::initCPML (&b, &c, &kappaInv, dist, boundary, intScheme->getGridStep (), intScheme->getGridTimeStep ());
+
+        profiles[k]->set (i, b, c, kappaInv);
+      }
+    }
+  }
+}
+
+/**
+ * Get coefficients of CPML for both derivatives in curl of specific field
+ *
+ * @return array of two profiles (some might be NULLPTR if derivative is not computed in this scheme)
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+CPMLProfile **
+Scheme<Type, TCoord, layout_type>::getCPMLProfiles ()
+{
+  switch (grid_type)
+  {
+    case (static_cast<uint8_t> (GridType::EX)):
+    {
+      return cpmlProfilesEx;
+    }
+    case (static_cast<uint8_t> (GridType::EY)):
+    {
+      return cpmlProfilesEy;
+    }
+    case (static_cast<uint8_t> (GridType::EZ)):
+    {
+      return cpmlProfilesEz;
+    }
+    case (static_cast<uint8_t> (GridType::HX)):
+    {
+      return cpmlProfilesHx;
+    }
+    case (static_cast<uint8_t> (GridType::HY)):
+    {
+      return cpmlProfilesHy;
+    }
+    case (static_cast<uint8_t> (GridType::HZ)):
+    {
+      return cpmlProfilesHz;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  return NULLPTR;
+}
+
+/**
+ * Get total position of zero relative position in grids of specific field
+ *
+ * @return total position of zero relative position
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+typename Scheme<Type, TCoord, layout_type>::TC
+Scheme<Type, TCoord, layout_type>::getTotalPositionDiff ()
+{
+  if (useParallel)
+  {
+#ifdef PARALLEL_GRID
+    return getGroup<grid_type> ()->getStartPosition ();
+#else /* PARALLEL_GRID */
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
+#endif /* !PARALLEL_GRID */
+  }
+
+  return TC::initAxesCoordinate (0, 0, 0, ct1, ct2, ct3);
+}
+
+/**
+ * Split chunk [start, end) into strips, which cover all chunk except for the interior part [interiorStart, interiorEnd)
+ * (see InternalSchemeHelper::getBorderStrips)
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::getBorderStrips (TC start, /**< start coordinate of chunk */
+                                                    TC end, /**< end coordinate of chunk */
+                                                    TC interiorStart, /**< start coordinate of interior part */
+                                                    TC interiorEnd, /**< end coordinate of interior part */
+                                                    std::vector<TC> &stripStart, /**< out: start coordinates of strips */
+                                                    std::vector<TC> &stripEnd, /**< out: end coordinates of strips */
+                                                    TC &clampedStart, /**< out: start coordinate of clamped interior */
+                                                    TC &clampedEnd) /**< out: end coordinate of clamped interior */
+{
+  InternalSchemeHelper::getBorderStrips<TCoord> (start, end, interiorStart, interiorEnd, stripStart, stripEnd,
+                                                 clampedStart, clampedEnd, ct1, ct2, ct3);
+}
+
+/**
+ * Initialize active region (see --use-active-region).
+ *
+ * Initially active region contains positions of point and current sources, TF/SF box and all points with non-zero
+ * initial values. Border conditions and right side functions might make any point non-zero, so active region is
+ * not tracked with them.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::initActiveRegion ()
+{
+  doTrackActiveRegion = false;
+
+  if (!SOLVER_SETTINGS.getDoUseActiveRegion ())
+  {
+    return;
+  }
+
+  if (intScheme->getCallbackExBorder () != NULLPTR
+      || intScheme->getCallbackEyBorder () != NULLPTR
+      || intScheme->getCallbackEzBorder () != NULLPTR
+      || intScheme->getCallbackHxBorder () != NULLPTR
+      || intScheme->getCallbackHyBorder () != NULLPTR
+      || intScheme->getCallbackHzBorder () != NULLPTR
+      || intScheme->getCallbackJx () != NULLPTR
+      || intScheme->getCallbackJy () != NULLPTR
+      || intScheme->getCallbackJz () != NULLPTR
+      || intScheme->getCallbackMx () != NULLPTR
+      || intScheme->getCallbackMy () != NULLPTR
+      || intScheme->getCallbackMz () != NULLPTR)
+  {
+    DPRINTF (LOG_LEVEL_STAGES, "Active region is not tracked with border conditions and right side functions.\n");
+    return;
+  }
+
+  doTrackActiveRegion = true;
+
+  /*
+   * Start with empty region
+   */
+  activeStart = yeeLayout->getSize ();
+  activeEnd = yeeLayout->getSize ().getZero ();
+
+  TC one = TC_COORD (1, 1, 1, ct1, ct2, ct3);
+
+  if (SOLVER_SETTINGS.getDoUsePointSourceEx ()
+      || SOLVER_SETTINGS.getDoUsePointSourceEy ()
+      || SOLVER_SETTINGS.getDoUsePointSourceEz ()
+      || SOLVER_SETTINGS.getDoUsePointSourceHx ()
+      || SOLVER_SETTINGS.getDoUsePointSourceHy ()
+      || SOLVER_SETTINGS.getDoUsePointSourceHz ())
+  {
+    TC pos = TC::initAxesCoordinate (SOLVER_SETTINGS.getPointSourceX (),
+                                     SOLVER_SETTINGS.getPointSourceY (),
+                                     SOLVER_SETTINGS.getPointSourceZ (),
+                                     ct1, ct2, ct3);
+    extendActiveRegion (pos, pos + one);
+  }
+
+  if (SOLVER_SETTINGS.getDoUseCurrentSourceJx ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceJy ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceJz ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceMx ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceMy ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceMz ())
+  {
+    TC pos = TC::initAxesCoordinate (SOLVER_SETTINGS.getCurrentSourceX (),
+                                     SOLVER_SETTINGS.getCurrentSourceY (),
+                                     SOLVER_SETTINGS.getCurrentSourceZ (),
+                                     ct1, ct2, ct3);
+    extendActiveRegion (pos, pos + one);
+  }
+
+  if (SOLVER_SETTINGS.getDoUseTFSF ())
+  {
+    extendActiveRegion (yeeLayout->getLeftBorderTFSF (), yeeLayout->getRightBorderTFSF () + one);
+  }
+
+  if (intScheme->getDoNeedEx ())
+  {
+    extendActiveRegionByGrid (intScheme->getEx ());
+  }
+  if (intScheme->getDoNeedEy ())
+  {
+    extendActiveRegionByGrid (intScheme->getEy ());
+  }
+  if (intScheme->getDoNeedEz ())
+  {
+    extendActiveRegionByGrid (intScheme->getEz ());
+  }
+  if (intScheme->getDoNeedHx ())
+  {
+    extendActiveRegionByGrid (intScheme->getHx ());
+  }
+  if (intScheme->getDoNeedHy ())
+  {
+    extendActiveRegionByGrid (intScheme->getHy ());
+  }
+  if (intScheme->getDoNeedHz ())
+  {
+    extendActiveRegionByGrid (intScheme->getHz ());
+  }
+
+  /*
+   * Points of TF/SF update and points of different fields with the same position are at most one cell away from
+   * the points, which were added above
+   */
+  growActiveRegion ();
+}
+
+/**
+ * Extend active region to bounding box of active region and [start, end)
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::extendActiveRegion (TC start, /**< start absolute coordinate */
+                                                       TC end) /**< end absolute coordinate */
+{
+  GridCoordinate3D start3D;
+  GridCoordinate3D end3D;
+  GridCoordinate3D activeStart3D;
+  GridCoordinate3D activeEnd3D;
+
+  expandTo3DStartEnd (start, end, start3D, end3D, ct1, ct2, ct3);
+  expandTo3DStartEnd (activeStart, activeEnd, activeStart3D, activeEnd3D, ct1, ct2, ct3);
+
+  grid_coord s[3] = { start3D.get1 (), start3D.get2 (), start3D.get3 () };
+  grid_coord e[3] = { end3D.get1 (), end3D.get2 (), end3D.get3 () };
+  grid_coord as[3] = { activeStart3D.get1 (), activeStart3D.get2 (), activeStart3D.get3 () };
+  grid_coord ae[3] = { activeEnd3D.get1 (), activeEnd3D.get2 (), activeEnd3D.get3 () };
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    as[axis] = s[axis] < as[axis] ? s[axis] : as[axis];
+    ae[axis] = e[axis] > ae[axis] ? e[axis] : ae[axis];
+  }
+
+  activeStart = TC::initAxesCoordinate (as[0], as[1], as[2], ct1, ct2, ct3);
+  activeEnd = TC::initAxesCoordinate (ae[0], ae[1], ae[2], ct1, ct2, ct3);
+}
+
+/**
+ * Extend active region to contain all points of grid with non-zero values
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::extendActiveRegionByGrid (Grid<TC> *grid) /**< grid of field */
+{
+  TC one = TC_COORD (1, 1, 1, ct1, ct2, ct3);
+
+  typename VectorFieldValues<TC>::Iterator iter = grid->begin ();
+  typename VectorFieldValues<TC>::Iterator iter_end = grid->end ();
+  for (; iter != iter_end; ++iter)
+  {
+    TC pos = iter.getPos ();
+
+    if (*grid->getFieldValue (pos, 0) != FIELDVALUE (0, 0))
+    {
+      TC posAbs = grid->getTotalPosition (pos);
+      extendActiveRegion (posAbs, posAbs + one);
+    }
+  }
+}
+
+/**
+ * Grow active region by one cell in all directions before update of E or H fields. Update of each point uses only
+ * values at the same position and at neighbor positions of opposite fields, so after update non-zero values remain
+ * in grown region.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::growActiveRegion ()
+{
+  if (!doTrackActiveRegion)
+  {
+    return;
+  }
+
+  GridCoordinate3D activeStart3D;
+  GridCoordinate3D activeEnd3D;
+  GridCoordinate3D zero3D;
+  GridCoordinate3D size3D;
+
+  expandTo3DStartEnd (activeStart, activeEnd, activeStart3D, activeEnd3D, ct1, ct2, ct3);
+  expandTo3DStartEnd (yeeLayout->getSize ().getZero (), yeeLayout->getSize (), zero3D, size3D, ct1, ct2, ct3);
+
+  grid_coord as[3] = { activeStart3D.get1 (), activeStart3D.get2 (), activeStart3D.get3 () };
+  grid_coord ae[3] = { activeEnd3D.get1 (), activeEnd3D.get2 (), activeEnd3D.get3 () };
+  grid_coord size[3] = { size3D.get1 (), size3D.get2 (), size3D.get3 () };
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (as[axis] >= ae[axis])
+    {
+      /*
+       * Empty region remains empty
+       */
+      return;
+    }
+  }
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    as[axis] = as[axis] > 0 ? as[axis] - 1 : 0;
+    ae[axis] = ae[axis] < size[axis] ? ae[axis] + 1 : size[axis];
+  }
+
+  activeStart = TC::initAxesCoordinate (as[0], as[1], as[2], ct1, ct2, ct3);
+  activeEnd = TC::initAxesCoordinate (ae[0], ae[1], ae[2], ct1, ct2, ct3);
+}
+
+/**
+ * Get part of chunk [start, end), which is inside of active region. Part might be empty.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::getActiveChunk (TC start, /**< start coordinate of chunk */
+                                                   TC end, /**< end coordinate of chunk */
+                                                   TC &activeChunkStart, /**< out: start coordinate of active part */
+                                                   TC &activeChunkEnd) /**< out: end coordinate of active part */
+{
+  /*
+   * Active region is tracked only for sequential grids, for which positions in grids are absolute positions
+   */
+  ASSERT (!useParallel);
+
+  GridCoordinate3D start3D;
+  GridCoordinate3D end3D;
+  GridCoordinate3D activeStart3D;
+  GridCoordinate3D activeEnd3D;
+
+  expandTo3DStartEnd (start, end, start3D, end3D, ct1, ct2, ct3);
+  expandTo3DStartEnd (activeStart, activeEnd, activeStart3D, activeEnd3D, ct1, ct2, ct3);
+
+  grid_coord s[3] = { start3D.get1 (), start3D.get2 (), start3D.get3 () };
+  grid_coord e[3] = { end3D.get1 (), end3D.get2 (), end3D.get3 () };
+  grid_coord as[3] = { activeStart3D.get1 (), activeStart3D.get2 (), activeStart3D.get3 () };
+  grid_coord ae[3] = { activeEnd3D.get1 (), activeEnd3D.get2 (), activeEnd3D.get3 () };
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    s[axis] = as[axis] > s[axis] ? as[axis] : s[axis];
+    e[axis] = ae[axis] < e[axis] ? ae[axis] : e[axis];
+    e[axis] = e[axis] > s[axis] ? e[axis] : s[axis];
+  }
+
+  activeChunkStart = TC::initAxesCoordinate (s[0], s[1], s[2], ct1, ct2, ct3);
+  activeChunkEnd = TC::initAxesCoordinate (e[0], e[1], e[2], ct1, ct2, ct3);
+}
+
+/**
+ * Get arguments of general FDTD update of specific field, which define its Ca and Cb coefficients
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type, bool usePML>
+void
+Scheme<Type, TCoord, layout_type>::getCaCbArgs (Grid<TC> **grid, /**< out: grid of field */
+                                                GridType *gridType, /**< out: type of grid of field */
+                                                Grid<TC> **materialGrid, /**< out: grid of material */
+                                                GridType *materialGridType, /**< out: type of grid of material */
+                                                FPValue *materialModifier) /**< out: modifier of material */
+{
+  Grid<TC> *materialGrid1 = NULLPTR;
+  GridType materialGridType1 = GridType::NONE;
+  Grid<TC> *materialGrid2 = NULLPTR;
+  GridType materialGridType2 = GridType::NONE;
+  Grid<TC> *materialGrid3 = NULLPTR;
+  GridType materialGridType3 = GridType::NONE;
+  Grid<TC> *materialGrid4 = NULLPTR;
+  GridType materialGridType4 = GridType::NONE;
+  Grid<TC> *materialGrid5 = NULLPTR;
+  GridType materialGridType5 = GridType::NONE;
+
+  Grid<TC> *oppositeGrid1 = NULLPTR;
+  Grid<TC> *oppositeGrid2 = NULLPTR;
+
+  Grid<TC> *gridPML1 = NULLPTR;
+  GridType gridPMLType1 = GridType::NONE;
+  Grid<TC> *gridPML2 = NULLPTR;
+  GridType gridPMLType2 = GridType::NONE;
+
+  Grid<TC> *Ca = NULLPTR;
+  Grid<TC> *Cb = NULLPTR;
+  Grid<TC> *CB0 = NULLPTR;
+  Grid<TC> *CB1 = NULLPTR;
+  Grid<TC> *CB2 = NULLPTR;
+  Grid<TC> *CA1 = NULLPTR;
+  Grid<TC> *CA2 = NULLPTR;
+  Grid<TC> *CaPML = NULLPTR;
+  Grid<TC> *CbPML = NULLPTR;
+  Grid<TC> *CcPML = NULLPTR;
+
+  SourceCallBack rightSideFunc = NULLPTR;
+  SourceCallBack borderFunc = NULLPTR;
+  SourceCallBack exactFunc = NULLPTR;
+
+  intScheme->template calculateFieldStepInit<grid_type, usePML, false> (grid, gridType,
+    materialGrid, materialGridType, &materialGrid1, &materialGridType1, &materialGrid2, &materialGridType2,
+    &materialGrid3, &materialGridType3, &materialGrid4, &materialGridType4, &materialGrid5, &materialGridType5,
+    &oppositeGrid1, &oppositeGrid2, &gridPML1, &gridPMLType1, &gridPML2, &gridPMLType2,
+    &rightSideFunc, &borderFunc, &exactFunc, materialModifier, &Ca, &Cb,
+    &CB0, &CB1, &CB2, &CA1, &CA2, &CaPML, &CbPML, &CcPML);
+}
+
+/**
+ * Initialize classes of Ca and Cb coefficients of general FDTD update for specific field.
+ *
+ * Points with the same averaged material (and the same choice between PML and PML-free update) have the same
+ * coefficients. The most frequent CA_CB_CLASSES_MAX_COUNT materials get classes, coefficients of the rest of points
+ * are computed on each time step. Coefficients of classes are computed by the same function as during time steps,
+ * so results are the same as without classes.
+ *
+ * @return classes of coefficients
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+CaCbClasses *
+Scheme<Type, TCoord, layout_type>::initCaCbClasses (TC startDiff, /**< start of computed part of grid */
+                                                    TC endDiff) /**< distance from the end of computed part of grid
+                                                                 *   to the end of grid */
+{
+  /*
+   * Arguments of update without PML (index 0) and with PML (index 1)
+   */
+  Grid<TC> *grid[2] = { NULLPTR, NULLPTR };
+  GridType gridType[2] = { GridType::NONE, GridType::NONE };
+  Grid<TC> *materialGrid[2] = { NULLPTR, NULLPTR };
+  GridType materialGridType[2] = { GridType::NONE, GridType::NONE };
+  FPValue materialModifier[2] = { FPValue (0), FPValue (0) };
+
+  getCaCbArgs<grid_type, false> (&grid[0], &gridType[0], &materialGrid[0], &materialGridType[0], &materialModifier[0]);
+  if (SOLVER_SETTINGS.getDoUsePML ())
+  {
+    getCaCbArgs<grid_type, true> (&grid[1], &gridType[1], &materialGrid[1], &materialGridType[1], &materialModifier[1]);
+  }
+
+  TC size = grid[0]->getSize ();
+  grid_coord count = size.calculateTotalCoord ();
+
+  CaCbClasses *classes = new CaCbClasses (count, VectorFieldValues<TC>::getRowLength (size.getZero (), size));
+
+  /*
+   * Averaged material of each point and type of its update (-1 for points, which are never computed)
+   */
+  std::vector<FPValue> materials (count, FPValue (0));
+  std::vector<int8_t> updateTypes (count, -1);
+
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+  for (grid_coord index = 0; index < count; ++index)
+  {
+    TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
+
+    if (!(pos >= startDiff && pos < size - endDiff))
+    {
+      continue;
+    }
+
+    TC posAbs = grid[0]->getTotalPosition (pos);
+    int8_t updateType = isInPMLWithAuxiliaryFields (posAbs) ? 1 : 0;
+
+    updateTypes[index] = updateType;
+    if (materialGrid[updateType])
+    {
+      materials[index] = intScheme->getMaterial (posAbs, gridType[updateType],
+                                                 materialGrid[updateType], materialGridType[updateType]);
+    }
+  }
+
+  /*
+   * Number of points and the first point for each distinct material
+   */
+  typedef std::pair<int8_t, FPValue> MaterialKey;
+  std::map<MaterialKey, std::pair<grid_coord, grid_coord> > materialCount;
+  for (grid_coord index = 0; index < count; ++index)
+  {
+    if (updateTypes[index] < 0)
+    {
+      continue;
+    }
+
+    MaterialKey key (updateTypes[index], materials[index]);
+    typename std::map<MaterialKey, std::pair<grid_coord, grid_coord> >::iterator it = materialCount.find (key);
+    if (it == materialCount.end ())
+    {
+      materialCount[key] = std::make_pair (1, index);
+    }
+    else
+    {
+      it->second.first++;
+    }
+  }
+
+  std::vector<std::pair<grid_coord, MaterialKey> > sortedMaterials;
+  for (typename std::map<MaterialKey, std::pair<grid_coord, grid_coord> >::iterator it = materialCount.begin ();
+       it != materialCount.end (); ++it)
+  {
+    sortedMaterials.push_back (std::make_pair (it->second.first, it->first));
+  }
+  std::sort (sortedMaterials.rbegin (), sortedMaterials.rend ());
+
+  std::map<MaterialKey, uint8_t> materialClass;
+  for (size_t i = 0; i < sortedMaterials.size () && i < CA_CB_CLASSES_MAX_COUNT; ++i)
+  {
+    MaterialKey key = sortedMaterials[i].second;
+    int8_t updateType = key.first;
+
+    TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, materialCount[key].second);
+    TC posAbs = grid[0]->getTotalPosition (pos);
+
+    FieldValue valCa = FIELDVALUE (0, 0);
+    FieldValue valCb = FIELDVALUE (0, 0);
+    intScheme->template computeCaCb<false> (valCa, valCb, pos, posAbs, NULLPTR, NULLPTR, updateType == 1,
+                                            gridType[updateType], materialGrid[updateType],
+                                            materialGridType[updateType], materialModifier[updateType]);
+
+    materialClass[key] = classes->addClass (valCa, valCb);
+  }
+
+  for (grid_coord index = 0; index < count; ++index)
+  {
+    if (updateTypes[index] < 0)
+    {
+      continue;
+    }
+
+    std::map<MaterialKey, uint8_t>::iterator it = materialClass.find (MaterialKey (updateTypes[index], materials[index]));
+    classes->setClass (index, it != materialClass.end () ? it->second : CA_CB_CLASS_NONE);
+  }
+
+  classes->initRuns ();
+
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Grid '%s': %u classes of Ca and Cb for %u distinct materials, " C_MOD " runs.\n",
+           grid[0]->getName (), (unsigned) classes->getClassCount (), (unsigned) sortedMaterials.size (),
+           classes->getRunCount ());
+
+  return classes;
+}
+
+/**
+ * Get classes of Ca and Cb coefficients of general FDTD update for specific field
+ *
+ * @return classes of coefficients or NULLPTR if they are not used
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+CaCbClasses *
+Scheme<Type, TCoord, layout_type>::getCaCbClasses ()
+{
+  switch (grid_type)
+  {
+    case (static_cast<uint8_t> (GridType::EX)):
+    {
+      return caCbClassesEx;
+    }
+    case (static_cast<uint8_t> (GridType::EY)):
+    {
+      return caCbClassesEy;
+    }
+    case (static_cast<uint8_t> (GridType::EZ)):
+    {
+      return caCbClassesEz;
+    }
+    case (static_cast<uint8_t> (GridType::HX)):
+    {
+      return caCbClassesHx;
+    }
+    case (static_cast<uint8_t> (GridType::HY)):
+    {
+      return caCbClassesHy;
+    }
+    case (static_cast<uint8_t> (GridType::HZ)):
+    {
+      return caCbClassesHz;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  return NULLPTR;
+}
 
-  bool doUsePointSource;
+#ifdef PARALLEL_GRID
+/**
+ * Get interior part of chunk for specific field, i.e. part, computations for which don't read values from buffers
+ * of parallel grids.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::getComputationInterior (TC Start, /**< start coordinate of chunk */
+                                                           TC End, /**< end coordinate of chunk */
+                                                           TC &interiorStart, /**< out: start coordinate of interior */
+                                                           TC &interiorEnd) /**< out: end coordinate of interior */
+{
+  ParallelGridGroup *group = getGroup<grid_type> ();
+
+  interiorStart = group->getComputationInteriorStart (Start);
+  interiorEnd = group->getComputationInteriorEnd (End);
+}
+
+/**
+ * Get group of parallel grids, which contains grids of specific field
+ *
+ * @return group of parallel grids
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+ParallelGridGroup *
+Scheme<Type, TCoord, layout_type>::getGroup ()
+{
+  ParallelGridGroup *group = NULLPTR;
   switch (grid_type)
   {
     case (static_cast<uint8_t> (GridType::EX)):
-    {
-      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceEx ();
-      break;
-    }
     case (static_cast<uint8_t> (GridType::EY)):
-    {
-      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceEy ();
-      break;
-    }
     case (static_cast<uint8_t> (GridType::EZ)):
     {
-      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceEz ();
+      group = eGroup;
       break;
     }
     case (static_cast<uint8_t> (GridType::HX)):
-    {
-      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceHx ();
-      break;
-    }
     case (static_cast<uint8_t> (GridType::HY)):
-    {
-      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceHy ();
-      break;
-    }
     case (static_cast<uint8_t> (GridType::HZ)):
     {
-      doUsePointSource = SOLVER_SETTINGS.getDoUsePointSourceHz ();
+      group = hGroup;
       break;
     }
     default:
@@ -851,21 +2219,30 @@ Scheme<Type, TCoord, layout_type>::performFieldSteps (time_step t, /**< time ste
     }
   }
 
-  if (doUsePointSource)
+  return group;
+}
+
+/**
+ * Perform computations of single time step for specific field for interior part of chunk. Computations for the rest
+ * of chunk should be finished by performFieldSteps.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::performFieldStepsInterior (time_step t, /**< time step to compute */
+                                                              TC Start, /**< start coordinate of chunk to compute */
+                                                              TC End) /**< end coordinate of chunk to compute */
+{
+  TC interiorStart;
+  TC interiorEnd;
+  getComputationInterior<grid_type> (Start, End, interiorStart, interiorEnd);
+
+  if (interiorStart < interiorEnd)
   {
-#ifdef CUDA_ENABLED
-    if (SOLVER_SETTINGS.getDoUseCuda ()
-        && SOLVER_SETTINGS.getIndexOfGPUForCurrentNode () != NO_GPU)
-    {
-      gpuIntSchemeOnGPU->template performPointSourceCalcKernelLaunch<grid_type> (d_gpuIntSchemeOnGPU, t);
-    }
-    else
-#endif /* CUDA_ENABLED */
-    {
-      intScheme->template performPointSourceCalc<grid_type> (t);
-    }
+    calculateFieldStepPart<grid_type> (t, interiorStart, interiorEnd, FieldStepPart::REGION);
   }
 }
+#endif /* PARALLEL_GRID */
 
 /**
  * Perform computations of single time step for specific field and for specified chunk for PML/metamaterials modes.
@@ -878,7 +2255,10 @@ template<uint8_t grid_type, bool usePML, bool useMetamaterials>
 void
 Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time step to calculate */
                                                        TC start, /**< start coordinate of chunk to perform computations on */
-                                                       TC end) /**< end coordinate of chunk to perform computations on */
+                                                       TC end, /**< end coordinate of chunk to perform computations on */
+                                                       FieldStepPart part, /**< part of computations to perform */
+                                                       bool doUseTFSF) /**< flag whether chunk might contain points,
+                                                                        *   which need TF/SF update */
 {
   if (useParallel)
   {
@@ -1028,8 +2408,11 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
 
   expandTo3DStartEnd (start, end, start3D, end3D, ct1, ct2, ct3);
 
+  bool doComputeRegion = part == FieldStepPart::ALL || part == FieldStepPart::REGION;
+  bool doFinalize = part == FieldStepPart::ALL || part == FieldStepPart::FINALIZE;
+
   // TODO: remove this check for each iteration
-  if (t > 0)
+  if (t > 0 && doComputeRegion)
   {
     /*
      * This timestep should be passed to rightside function, which is half step behind grid_type,
@@ -1094,12 +2477,61 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
     }
     else
 #endif /* CUDA_ENABLED */
+    if (rightSideFunc == NULLPTR
+        && !doUseTFSF
+        && !SOLVER_SETTINGS.getDoUsePerPointKernels ())
     {
-      typename VectorFieldValues<TC>::Iterator iter (start, start, end);
-      typename VectorFieldValues<TC>::Iterator iter_end = VectorFieldValues<TC>::Iterator::getEndIterator (start, end);
-      for (; iter != iter_end; ++iter)
+      /*
+       * Row kernels process whole contiguous rows (last coordinate changes) with hoisted pointers,
+       * which allows compiler to vectorize computations.
+       */
+      TC rowsEnd = VectorFieldValues<TC>::getRowStartsEnd (start, end);
+      grid_coord rowLength = VectorFieldValues<TC>::getRowLength (start, end);
+      CaCbClasses *classes = getCaCbClasses<grid_type> ();
+
+      if (rowLength > 0)
       {
-        TC pos = iter.getPos ();
+        grid_coord rowCount = (rowsEnd - start).calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+        for (grid_coord row = 0; row < rowCount; ++row)
+        {
+          TC pos = VectorFieldValues<TC>::getPosition (start, rowsEnd, row);
+          TC posAbs = grid->getTotalPosition (pos);
+
+          if (SOLVER_SETTINGS.getDoUseCaCbGrids ())
+          {
+            intScheme->template calculateFieldStepIterationRow<grid_type, true> (pos, posAbs, end, rowLength,
+                                                                                 diff11, diff12, diff21, diff22,
+                                                                                 grid, oppositeGrid1, oppositeGrid2, Ca, Cb,
+                                                                                 NULLPTR,
+                                                                                 usePML,
+                                                                                 gridType, materialGrid, materialGridType,
+                                                                                 materialModifier);
+          }
+          else
+          {
+            intScheme->template calculateFieldStepIterationRow<grid_type, false> (pos, posAbs, end, rowLength,
+                                                                                  diff11, diff12, diff21, diff22,
+                                                                                  grid, oppositeGrid1, oppositeGrid2, Ca, Cb,
+                                                                                  classes,
+                                                                                  usePML,
+                                                                                  gridType, materialGrid, materialGridType,
+                                                                                  materialModifier);
+          }
+        }
+      }
+    }
+    else
+    {
+      grid_coord count = (end - start).calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
+      {
+        TC pos = VectorFieldValues<TC>::getPosition (start, end, index);
 
         // TODO: add getTotalPositionDiff here, which will be called before loop
         TC posAbs = grid->getTotalPosition (pos);
@@ -1225,6 +2657,19 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
       }
     }
 
+    if (doComputeCurrentSource)
+    {
+      /*
+       * Chunk might be only a part of grid, so current source is applied only by the chunk, which contains it
+       */
+      TC currentPos = TC::initAxesCoordinate (SOLVER_SETTINGS.getCurrentSourceX (),
+                                              SOLVER_SETTINGS.getCurrentSourceY (),
+                                              SOLVER_SETTINGS.getCurrentSourceZ (),
+                                              ct1, ct2, ct3);
+      doComputeCurrentSource = currentPos >= grid->getTotalPosition (start)
+                               && currentPos < grid->getTotalPosition (end);
+    }
+
     if (doComputeCurrentSource)
     {
       FieldValue current = FIELDVALUE (0, 0);
@@ -1281,11 +2726,13 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
         else
 #endif /* CUDA_ENABLED */
         {
-          typename VectorFieldValues<TC>::Iterator iter (start, start, end);
-          typename VectorFieldValues<TC>::Iterator iter_end = VectorFieldValues<TC>::Iterator::getEndIterator (start, end);
-          for (; iter != iter_end; ++iter)
+          grid_coord count = (end - start).calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+          for (grid_coord index = 0; index < count; ++index)
           {
-            TC pos = iter.getPos ();
+            TC pos = VectorFieldValues<TC>::getPosition (start, end, index);
 
             if (SOLVER_SETTINGS.getDoUseCaCbPMLMetaGrids ())
             {
@@ -1320,11 +2767,13 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
       else
 #endif /* CUDA_ENABLED */
       {
-        typename VectorFieldValues<TC>::Iterator iter (start, start, end);
-        typename VectorFieldValues<TC>::Iterator iter_end = VectorFieldValues<TC>::Iterator::getEndIterator (start, end);
-        for (; iter != iter_end; ++iter)
+        grid_coord count = (end - start).calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+        for (grid_coord index = 0; index < count; ++index)
         {
-          TC pos = iter.getPos ();
+          TC pos = VectorFieldValues<TC>::getPosition (start, end, index);
 
           if (SOLVER_SETTINGS.getDoUseCaCbPMLGrids ())
           {
@@ -1343,7 +2792,8 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
     }
   }
 
-  if (borderFunc != NULLPTR)
+  if (doFinalize
+      && borderFunc != NULLPTR)
   {
     GridCoordinate3D startBorder;
     GridCoordinate3D endBorder;
@@ -1373,7 +2823,8 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
     }
   }
 
-  if (exactFunc != NULLPTR)
+  if (doFinalize
+      && exactFunc != NULLPTR)
   {
     FPValue normRe = 0.0;
     FPValue normIm = 0.0;
@@ -1563,7 +3014,7 @@ Scheme<Type, TCoord, layout_type>::estimateCurrentSize ()
    */
 
 #define GRID_NAME(x, y, steps, time_offset) \
-  size += intScheme->has ## x () ? intScheme->get ## x ()->getSize ().calculateTotalCoord () * intScheme->get ## x ()->getCountStoredSteps () * sizeof (FieldValue) + sizeof (Grid<TC>) : 0;
+  size += intScheme->has ## x () ? intScheme->get ## x ()->getCountAllocatedValues () * sizeof (FieldValue) + sizeof (Grid<TC>) : 0;
 #define GRID_NAME_NO_CHECK(x, y, steps, time_offset) \
   GRID_NAME(x, y, steps, time_offset)
 #include "Grids2.inc.h"
@@ -1832,6 +3283,10 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
 #ifdef PARALLEL_GRID
   , eGroup (NULLPTR)
   , hGroup (NULLPTR)
+  , doOverlapShare (false)
+  , doShareAuxiliary (false)
+  , isShareEPending (false)
+  , isShareHPending (false)
 #endif /* PARALLEL_GRID */
   , totalTimeSteps (0)
   , NTimeSteps (0)
@@ -1860,7 +3315,24 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
   , ct2 (intScheme->get_ct2 ())
   , ct3 (intScheme->get_ct3 ())
   , yeeLayout (layout)
+  , caCbClassesEx (NULLPTR)
+  , caCbClassesEy (NULLPTR)
+  , caCbClassesEz (NULLPTR)
+  , caCbClassesHx (NULLPTR)
+  , caCbClassesHy (NULLPTR)
+  , caCbClassesHz (NULLPTR)
+  , doTrackActiveRegion (false)
 {
+  for (int i = 0; i < 2; ++i)
+  {
+    cpmlProfilesEx[i] = NULLPTR;
+    cpmlProfilesEy[i] = NULLPTR;
+    cpmlProfilesEz[i] = NULLPTR;
+    cpmlProfilesHx[i] = NULLPTR;
+    cpmlProfilesHy[i] = NULLPTR;
+    cpmlProfilesHz[i] = NULLPTR;
+  }
+
   ASSERT (!SOLVER_SETTINGS.getDoUseTFSF ()
           || (SOLVER_SETTINGS.getDoUseTFSF ()
               && (yeeLayout->getLeftBorderTFSF () != TC (0, 0, 0, ct1, ct2, ct3)
@@ -1883,6 +3355,27 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
   }
 #endif
 
+  if (SOLVER_SETTINGS.getDoUseCPML ())
+  {
+    if (!SOLVER_SETTINGS.getDoUsePML ())
+    {
+      ALWAYS_ASSERT_MESSAGE ("CPML requires PML, use --use-pml together with --use-cpml");
+    }
+    if (SOLVER_SETTINGS.getDoUseMetamaterials ()
+        || SOLVER_SETTINGS.getDoUseCuda ()
+        || useParallel)
+    {
+      ALWAYS_ASSERT_MESSAGE ("CPML is not implemented for metamaterials, CUDA and parallel grids");
+    }
+  }
+
+  if (SOLVER_SETTINGS.getDoUseActiveRegion ()
+      && (SOLVER_SETTINGS.getDoUseCuda ()
+          || useParallel))
+  {
+    ALWAYS_ASSERT_MESSAGE ("Active region is not implemented for CUDA and parallel grids");
+  }
+
   intScheme->init (layout, useParallel);
 
   if (!useParallel)
@@ -1937,9 +3430,26 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
     }
 
     ASSERT (hGroup != NULLPTR);
-#endif /* PARALLEL_GRID */
 
-    if (SOLVER_SETTINGS.getDoSaveMaterials ())
+    /*
+     * Dynamic grid measures time of blocking share operations, and current sources modify field values between
+     * update of field and update of PML, so computations can't be split in interior and border parts for them.
+     */
+    doOverlapShare = !SOLVER_SETTINGS.getDoUseDynamicGrid ()
+                     && !SOLVER_SETTINGS.getDoUseCurrentSourceJx ()
+                     && !SOLVER_SETTINGS.getDoUseCurrentSourceJy ()
+                     && !SOLVER_SETTINGS.getDoUseCurrentSourceJz ()
+                     && !SOLVER_SETTINGS.getDoUseCurrentSourceMx ()
+                     && !SOLVER_SETTINGS.getDoUseCurrentSourceMy ()
+                     && !SOLVER_SETTINGS.getDoUseCurrentSourceMz ();
+
+    initShareTimeLayers ();
+
+    /*
+     * Full grids of materials are gathered and saved only on root node
+     */
+    if (SOLVER_SETTINGS.getDoSaveMaterials ()
+        && ParallelGrid::getParallelCore ()->getProcessId () == 0)
     {
       totalEps = new Grid<TC> (yeeLayout->getEpsSize (), intScheme->getEps ()->getCountStoredSteps (), "Eps");
       totalMu = new Grid<TC> (yeeLayout->getMuSize (), intScheme->getMu ()->getCountStoredSteps (), "Mu");
@@ -1952,6 +3462,7 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
         totalGammaM = new Grid<TC> (yeeLayout->getEpsSize (), intScheme->getGammaM ()->getCountStoredSteps (), "GammaM");
       }
     }
+#endif /* PARALLEL_GRID */
   }
 
   if (SOLVER_SETTINGS.getDoSaveAsBMP ())
@@ -2122,6 +3633,23 @@ Scheme<Type, TCoord, layout_type>::~Scheme ()
 #endif /* !PARALLEL_GRID */
   }
 
+  delete caCbClassesEx;
+  delete caCbClassesEy;
+  delete caCbClassesEz;
+  delete caCbClassesHx;
+  delete caCbClassesHy;
+  delete caCbClassesHz;
+
+  for (int i = 0; i < 2; ++i)
+  {
+    delete cpmlProfilesEx[i];
+    delete cpmlProfilesEy[i];
+    delete cpmlProfilesEz[i];
+    delete cpmlProfilesHx[i];
+    delete cpmlProfilesHy[i];
+    delete cpmlProfilesHz[i];
+  }
+
   delete dumper[FILE_TYPE_BMP];
   delete dumper[FILE_TYPE_DAT];
   delete dumper[FILE_TYPE_TXT];
@@ -2143,6 +3671,7 @@ Scheme<Type, TCoord, layout_type>::initScheme (FPValue dx, FPValue sourceWaveLen
 
   initCallBacks ();
   initGrids ();
+  initActiveRegion ();
   initBlocks (t_total);
 }
 
@@ -2839,11 +4368,15 @@ Scheme<Type, TCoord, layout_type>::initMaterialFromFile (GridType gridType, Grid
   std::vector< std::string > fileNames (1);
   fileNames[0] = filename;
 
-  loader[type]->loadGrid (totalGrid, zero, totalGrid->getSize (), 0, 0, fileNames);
-
   if (useParallel)
   {
 #ifdef PARALLEL_GRID
+    /*
+     * Full grids of materials are allocated only on root node, so file is loaded to temporary grid on each node
+     */
+    totalGrid = new Grid<TC> (grid->getTotalSize (), 1, grid->getName ());
+    loader[type]->loadGrid (totalGrid, zero, totalGrid->getSize (), 0, 0, fileNames);
+
     typename VectorFieldValues<TC>::Iterator iter = grid->begin ();
     typename VectorFieldValues<TC>::Iterator iter_end = grid->end ();
     for (; iter != iter_end; ++iter)
@@ -2854,10 +4387,16 @@ Scheme<Type, TCoord, layout_type>::initMaterialFromFile (GridType gridType, Grid
       FieldValue *val = grid->getFieldValue (pos, 0);
       *val = *totalGrid->getFieldValue (posAbs, 0);
     }
+
+    delete totalGrid;
 #else
     ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
 #endif
   }
+  else
+  {
+    loader[type]->loadGrid (totalGrid, zero, totalGrid->getSize (), 0, 0, fileNames);
+  }
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
@@ -3310,11 +4849,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
   {
     if (intScheme->getDoNeedEx ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEx ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEx ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEx ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getExStartDiff () && pos < intScheme->getEx ()->getSize () - yeeLayout->getExEndDiff ()))
         {
@@ -3328,7 +4870,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
         TC posAbs = intScheme->getEx ()->getTotalPosition (pos);
 
-        if (SOLVER_SETTINGS.getDoUsePML ())
+        if (isInPMLWithAuxiliaryFields (posAbs))
         {
           FPValue material = intScheme->hasSigmaY () ? intScheme->getMaterial (posAbs, GridType::EX, intScheme->getSigmaY (), GridType::SIGMAY) : 0;
           FPValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
@@ -3349,11 +4891,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedEy ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEy ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEy ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEy ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getEyStartDiff () && pos < intScheme->getEy ()->getSize () - yeeLayout->getEyEndDiff ()))
         {
@@ -3367,7 +4912,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
         TC posAbs = intScheme->getEy ()->getTotalPosition (pos);
 
-        if (SOLVER_SETTINGS.getDoUsePML ())
+        if (isInPMLWithAuxiliaryFields (posAbs))
         {
           FPValue material = intScheme->hasSigmaZ () ? intScheme->getMaterial (posAbs, GridType::EY, intScheme->getSigmaZ (), GridType::SIGMAZ) : 0;
           FPValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
@@ -3388,11 +4933,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedEz ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEz ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEz ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEz ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getEzStartDiff () && pos < intScheme->getEz ()->getSize () - yeeLayout->getEzEndDiff ()))
         {
@@ -3406,7 +4954,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
         TC posAbs = intScheme->getEz ()->getTotalPosition (pos);
 
-        if (SOLVER_SETTINGS.getDoUsePML ())
+        if (isInPMLWithAuxiliaryFields (posAbs))
         {
           FPValue material = intScheme->hasSigmaX () ? intScheme->getMaterial (posAbs, GridType::EZ, intScheme->getSigmaX (), GridType::SIGMAX) : 0;
           FPValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
@@ -3427,11 +4975,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHx ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHx ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHx ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHx ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getHxStartDiff () && pos < intScheme->getHx ()->getSize () - yeeLayout->getHxEndDiff ()))
         {
@@ -3445,7 +4996,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
         TC posAbs = intScheme->getHx ()->getTotalPosition (pos);
 
-        if (SOLVER_SETTINGS.getDoUsePML ())
+        if (isInPMLWithAuxiliaryFields (posAbs))
         {
           FPValue material = intScheme->hasSigmaY () ? intScheme->getMaterial (posAbs, GridType::HX, intScheme->getSigmaY (), GridType::SIGMAY) : 0;
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ())
@@ -3467,11 +5018,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHy ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHy ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHy ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHy ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getHyStartDiff () && pos < intScheme->getHy ()->getSize () - yeeLayout->getHyEndDiff ()))
         {
@@ -3485,7 +5039,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
         TC posAbs = intScheme->getHy ()->getTotalPosition (pos);
 
-        if (SOLVER_SETTINGS.getDoUsePML ())
+        if (isInPMLWithAuxiliaryFields (posAbs))
         {
           FPValue material = intScheme->hasSigmaZ () ? intScheme->getMaterial (posAbs, GridType::HY, intScheme->getSigmaZ (), GridType::SIGMAZ) : 0;
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ())
@@ -3507,11 +5061,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHz ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHz ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHz ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHz ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getHzStartDiff () && pos < intScheme->getHz ()->getSize () - yeeLayout->getHzEndDiff ()))
         {
@@ -3525,7 +5082,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
         TC posAbs = intScheme->getHz ()->getTotalPosition (pos);
 
-        if (SOLVER_SETTINGS.getDoUsePML ())
+        if (isInPMLWithAuxiliaryFields (posAbs))
         {
           FPValue material = intScheme->hasSigmaX () ? intScheme->getMaterial (posAbs, GridType::HZ, intScheme->getSigmaX (), GridType::SIGMAX) : 0;
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ())
@@ -3546,17 +5103,79 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
     }
   }
 
+  if (SOLVER_SETTINGS.getDoUseCaCbClasses ()
+      && !SOLVER_SETTINGS.getDoUseCaCbGrids ()
+      && !SOLVER_SETTINGS.getDoUseCuda ())
+  {
+    if (intScheme->getDoNeedEx ())
+    {
+      caCbClassesEx = initCaCbClasses<static_cast<uint8_t> (GridType::EX)> (yeeLayout->getExStartDiff (), yeeLayout->getExEndDiff ());
+    }
+    if (intScheme->getDoNeedEy ())
+    {
+      caCbClassesEy = initCaCbClasses<static_cast<uint8_t> (GridType::EY)> (yeeLayout->getEyStartDiff (), yeeLayout->getEyEndDiff ());
+    }
+    if (intScheme->getDoNeedEz ())
+    {
+      caCbClassesEz = initCaCbClasses<static_cast<uint8_t> (GridType::EZ)> (yeeLayout->getEzStartDiff (), yeeLayout->getEzEndDiff ());
+    }
+    if (intScheme->getDoNeedHx ())
+    {
+      caCbClassesHx = initCaCbClasses<static_cast<uint8_t> (GridType::HX)> (yeeLayout->getHxStartDiff (), yeeLayout->getHxEndDiff ());
+    }
+    if (intScheme->getDoNeedHy ())
+    {
+      caCbClassesHy = initCaCbClasses<static_cast<uint8_t> (GridType::HY)> (yeeLayout->getHyStartDiff (), yeeLayout->getHyEndDiff ());
+    }
+    if (intScheme->getDoNeedHz ())
+    {
+      caCbClassesHz = initCaCbClasses<static_cast<uint8_t> (GridType::HZ)> (yeeLayout->getHzStartDiff (), yeeLayout->getHzEndDiff ());
+    }
+  }
+
+  if (doUseCPML ())
+  {
+    if (intScheme->getDoNeedEx ())
+    {
+      initCPMLProfiles<static_cast<uint8_t> (GridType::EX)> ();
+    }
+    if (intScheme->getDoNeedEy ())
+    {
+      initCPMLProfiles<static_cast<uint8_t> (GridType::EY)> ();
+    }
+    if (intScheme->getDoNeedEz ())
+    {
+      initCPMLProfiles<static_cast<uint8_t> (GridType::EZ)> ();
+    }
+    if (intScheme->getDoNeedHx ())
+    {
+      initCPMLProfiles<static_cast<uint8_t> (GridType::HX)> ();
+    }
+    if (intScheme->getDoNeedHy ())
+    {
+      initCPMLProfiles<static_cast<uint8_t> (GridType::HY)> ();
+    }
+    if (intScheme->getDoNeedHz ())
+    {
+      initCPMLProfiles<static_cast<uint8_t> (GridType::HZ)> ();
+    }
+  }
+
   if (SOLVER_SETTINGS.getDoUseCaCbPMLGrids () && SOLVER_SETTINGS.getDoUsePML ())
   {
     if (intScheme->getDoNeedEx ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEx ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEx ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEx ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
-        if (!(pos >= yeeLayout->getExStartDiff () && pos < intScheme->getEx ()->getSize () - yeeLayout->getExEndDiff ()))
+        if (!(pos >= yeeLayout->getExStartDiff () && pos < intScheme->getEx ()->getSize () - yeeLayout->getExEndDiff ())
+            || !intScheme->getCaPMLEx ()->isStored (pos))
         {
           continue;
         }
@@ -3590,13 +5209,17 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedEy ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEy ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEy ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEy ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
-        if (!(pos >= yeeLayout->getEyStartDiff () && pos < intScheme->getEy ()->getSize () - yeeLayout->getEyEndDiff ()))
+        if (!(pos >= yeeLayout->getEyStartDiff () && pos < intScheme->getEy ()->getSize () - yeeLayout->getEyEndDiff ())
+            || !intScheme->getCaPMLEy ()->isStored (pos))
         {
           continue;
         }
@@ -3630,13 +5253,17 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedEz ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEz ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEz ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEz ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
-        if (!(pos >= yeeLayout->getEzStartDiff () && pos < intScheme->getEz ()->getSize () - yeeLayout->getEzEndDiff ()))
+        if (!(pos >= yeeLayout->getEzStartDiff () && pos < intScheme->getEz ()->getSize () - yeeLayout->getEzEndDiff ())
+            || !intScheme->getCaPMLEz ()->isStored (pos))
         {
           continue;
         }
@@ -3670,13 +5297,17 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHx ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHx ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHx ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHx ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
-        if (!(pos >= yeeLayout->getHxStartDiff () && pos < intScheme->getHx ()->getSize () - yeeLayout->getHxEndDiff ()))
+        if (!(pos >= yeeLayout->getHxStartDiff () && pos < intScheme->getHx ()->getSize () - yeeLayout->getHxEndDiff ())
+            || !intScheme->getDaPMLHx ()->isStored (pos))
         {
           continue;
         }
@@ -3710,13 +5341,17 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHy ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHy ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHy ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHy ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
-        if (!(pos >= yeeLayout->getHyStartDiff () && pos < intScheme->getHy ()->getSize () - yeeLayout->getHyEndDiff ()))
+        if (!(pos >= yeeLayout->getHyStartDiff () && pos < intScheme->getHy ()->getSize () - yeeLayout->getHyEndDiff ())
+            || !intScheme->getDaPMLHy ()->isStored (pos))
         {
           continue;
         }
@@ -3750,13 +5385,17 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHz ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHz ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHz ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHz ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
-        if (!(pos >= yeeLayout->getHzStartDiff () && pos < intScheme->getHz ()->getSize () - yeeLayout->getHzEndDiff ()))
+        if (!(pos >= yeeLayout->getHzStartDiff () && pos < intScheme->getHz ()->getSize () - yeeLayout->getHzEndDiff ())
+            || !intScheme->getDaPMLHz ()->isStored (pos))
         {
           continue;
         }
@@ -3795,11 +5434,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
   {
     if (intScheme->getDoNeedEx ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEx ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEx ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEx ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getExStartDiff () && pos < intScheme->getEx ()->getSize () - yeeLayout->getExEndDiff ()))
         {
@@ -3834,11 +5476,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedEy ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEy ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEy ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEy ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getEyStartDiff () && pos < intScheme->getEy ()->getSize () - yeeLayout->getEyEndDiff ()))
         {
@@ -3873,11 +5518,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedEz ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getEz ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getEz ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getEz ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getEzStartDiff () && pos < intScheme->getEz ()->getSize () - yeeLayout->getEzEndDiff ()))
         {
@@ -3912,11 +5560,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHx ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHx ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHx ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHx ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getHxStartDiff () && pos < intScheme->getHx ()->getSize () - yeeLayout->getHxEndDiff ()))
         {
@@ -3951,11 +5602,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHy ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHy ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHy ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHy ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getHyStartDiff () && pos < intScheme->getHy ()->getSize () - yeeLayout->getHyEndDiff ()))
         {
@@ -3990,11 +5644,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (intScheme->getDoNeedHz ())
     {
-      typename VectorFieldValues<TC>::Iterator iter = intScheme->getHz ()->begin ();
-      typename VectorFieldValues<TC>::Iterator iter_end = intScheme->getHz ()->end ();
-      for (; iter != iter_end; ++iter)
+      TC size = intScheme->getHz ()->getSize ();
+      grid_coord count = size.calculateTotalCoord ();
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for schedule (static)
+#endif /* OPENMP_ENABLED */
+      for (grid_coord index = 0; index < count; ++index)
       {
-        TC pos = iter.getPos ();
+        TC pos = VectorFieldValues<TC>::getPosition (size.getZero (), size, index);
 
         if (!(pos >= yeeLayout->getHzStartDiff () && pos < intScheme->getHz ()->getSize () - yeeLayout->getHzEndDiff ()))
         {
@@ -4027,6 +5684,42 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
       }
     }
   }
+
+  /*
+   * Materials are not changed after initialization, so their grids could be stored compactly. Dynamic grid resizes
+   * all grids during rebalance, and CUDA copies raw storage of grids, so compact grids are not used with them.
+   */
+  if (SOLVER_SETTINGS.getDoUseCompactMaterials ()
+      && !SOLVER_SETTINGS.getDoUseCuda ()
+      && !(useParallel && SOLVER_SETTINGS.getDoUseDynamicGrid ()))
+  {
+    intScheme->getEps ()->compact ();
+    intScheme->getMu ()->compact ();
+
+    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    {
+      intScheme->getOmegaPE ()->compact ();
+      intScheme->getOmegaPM ()->compact ();
+      intScheme->getGammaE ()->compact ();
+      intScheme->getGammaM ()->compact ();
+    }
+
+    if (SOLVER_SETTINGS.getDoUsePML ())
+    {
+      if (intScheme->getDoNeedSigmaX ())
+      {
+        intScheme->getSigmaX ()->compact ();
+      }
+      if (intScheme->getDoNeedSigmaY ())
+      {
+        intScheme->getSigmaY ()->compact ();
+      }
+      if (intScheme->getDoNeedSigmaZ ())
+      {
+        intScheme->getSigmaZ ()->compact ();
+      }
+    }
+  }
 }
 
 /**
@@ -4108,6 +5801,28 @@ Scheme<Type, TCoord, layout_type>::Pointing_inc (FPValue angleTeta, FPValue angl
   return sqrt (PhysicsConst::Eps0 / PhysicsConst::Mu0) / FPValue (2);
 }
 
+/**
+ * Get end coordinate of region of auxiliary grids of incident wave, which is reached by wave at time step. Incident
+ * wave moves by at most one cell per time step, so further cells are still zero and are not updated.
+ *
+ * @return end coordinate of reached region of auxiliary grids of incident wave
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+GridCoordinate1D
+Scheme<Type, TCoord, layout_type>::getIncidentWaveEnd (time_step t) /**< time step */
+{
+  GridCoordinate1D size = intScheme->getEInc ()->getSize ();
+
+  ASSERT (size == intScheme->getHInc ()->getSize ());
+
+  if ((grid_coord) t + 2 < size.get1 ())
+  {
+    return GRID_COORDINATE_1D ((grid_coord) t + 2, CoordinateType::X);
+  }
+
+  return size;
+} /* Scheme::getIncidentWaveEnd */
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 void
 Scheme<Type, TCoord, layout_type>::makeGridScattered (Grid<TC> *grid, GridType gridType)
@@ -4332,6 +6047,17 @@ Scheme<Type, TCoord, layout_type>::gatherFieldsTotal (bool scattered)
     }
   }
 
+#ifdef PARALLEL_GRID
+  /*
+   * Full grids are gathered only on root node in parallel mode
+   */
+  if (useParallel
+      && ParallelGrid::getParallelCore ()->getProcessId () != 0)
+  {
+    return;
+  }
+#endif /* PARALLEL_GRID */
+
   if (scattered)
   {
     if (intScheme->getDoNeedEx ())
@@ -4377,6 +6103,18 @@ Scheme<Type, TCoord, layout_type>::saveGrids (time_step t)
 #endif
   }
 
+#ifdef PARALLEL_GRID
+  /*
+   * Full grids are gathered only on root node in parallel mode
+   */
+  if (useParallel
+      && !SOLVER_SETTINGS.getDoSaveResPerProcess ()
+      && ParallelGrid::getParallelCore ()->getProcessId () != 0)
+  {
+    return;
+  }
+#endif /* PARALLEL_GRID */
+
   TC startEx;
   TC endEx;
   TC startEy;
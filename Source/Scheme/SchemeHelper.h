@@ -260,15 +260,15 @@ public:
   {
 #ifdef PARALLEL_GRID
 #ifdef GRID_1D
-    ((ParallelGrid *) Eps)->gatherFullGridPlacement (totalEps);
-    ((ParallelGrid *) Mu)->gatherFullGridPlacement (totalMu);
+    ((ParallelGrid *) Eps)->gatherFullGridPlacement (totalEps, false);
+    ((ParallelGrid *) Mu)->gatherFullGridPlacement (totalMu, false);
 
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) OmegaPE)->gatherFullGridPlacement (totalOmegaPE);
-      ((ParallelGrid *) OmegaPM)->gatherFullGridPlacement (totalOmegaPM);
-      ((ParallelGrid *) GammaE)->gatherFullGridPlacement (totalGammaE);
-      ((ParallelGrid *) GammaM)->gatherFullGridPlacement (totalGammaM);
+      ((ParallelGrid *) OmegaPE)->gatherFullGridPlacement (totalOmegaPE, false);
+      ((ParallelGrid *) OmegaPM)->gatherFullGridPlacement (totalOmegaPM, false);
+      ((ParallelGrid *) GammaE)->gatherFullGridPlacement (totalGammaE, false);
+      ((ParallelGrid *) GammaM)->gatherFullGridPlacement (totalGammaM, false);
     }
 #else
     ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid for this dimension. "
@@ -289,15 +289,15 @@ public:
   {
 #ifdef PARALLEL_GRID
 #ifdef GRID_2D
-    ((ParallelGrid *) Eps)->gatherFullGridPlacement (totalEps);
-    ((ParallelGrid *) Mu)->gatherFullGridPlacement (totalMu);
+    ((ParallelGrid *) Eps)->gatherFullGridPlacement (totalEps, false);
+    ((ParallelGrid *) Mu)->gatherFullGridPlacement (totalMu, false);
 
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) OmegaPE)->gatherFullGridPlacement (totalOmegaPE);
-      ((ParallelGrid *) OmegaPM)->gatherFullGridPlacement (totalOmegaPM);
-      ((ParallelGrid *) GammaE)->gatherFullGridPlacement (totalGammaE);
-      ((ParallelGrid *) GammaM)->gatherFullGridPlacement (totalGammaM);
+      ((ParallelGrid *) OmegaPE)->gatherFullGridPlacement (totalOmegaPE, false);
+      ((ParallelGrid *) OmegaPM)->gatherFullGridPlacement (totalOmegaPM, false);
+      ((ParallelGrid *) GammaE)->gatherFullGridPlacement (totalGammaE, false);
+      ((ParallelGrid *) GammaM)->gatherFullGridPlacement (totalGammaM, false);
     }
 #else
     ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid for this dimension. "
@@ -318,15 +318,15 @@ public:
   {
 #ifdef PARALLEL_GRID
 #ifdef GRID_3D
-    ((ParallelGrid *) Eps)->gatherFullGridPlacement (totalEps);
-    ((ParallelGrid *) Mu)->gatherFullGridPlacement (totalMu);
+    ((ParallelGrid *) Eps)->gatherFullGridPlacement (totalEps, false);
+    ((ParallelGrid *) Mu)->gatherFullGridPlacement (totalMu, false);
 
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) OmegaPE)->gatherFullGridPlacement (totalOmegaPE);
-      ((ParallelGrid *) OmegaPM)->gatherFullGridPlacement (totalOmegaPM);
-      ((ParallelGrid *) GammaE)->gatherFullGridPlacement (totalGammaE);
-      ((ParallelGrid *) GammaM)->gatherFullGridPlacement (totalGammaM);
+      ((ParallelGrid *) OmegaPE)->gatherFullGridPlacement (totalOmegaPE, false);
+      ((ParallelGrid *) OmegaPM)->gatherFullGridPlacement (totalOmegaPM, false);
+      ((ParallelGrid *) GammaE)->gatherFullGridPlacement (totalGammaE, false);
+      ((ParallelGrid *) GammaM)->gatherFullGridPlacement (totalGammaM, false);
     }
 #else
     ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid for this dimension. "
@@ -352,56 +352,56 @@ public:
     {
       if (doNeedEx)
       {
-        *totalEx = ((ParallelGrid *) Ex)->gatherFullGridPlacement (*totalEx);
+        *totalEx = ((ParallelGrid *) Ex)->gatherFullGridPlacement (*totalEx, false);
       }
       if (doNeedEy)
       {
-        *totalEy = ((ParallelGrid *) Ey)->gatherFullGridPlacement (*totalEy);
+        *totalEy = ((ParallelGrid *) Ey)->gatherFullGridPlacement (*totalEy, false);
       }
       if (doNeedEz)
       {
-        *totalEz = ((ParallelGrid *) Ez)->gatherFullGridPlacement (*totalEz);
+        *totalEz = ((ParallelGrid *) Ez)->gatherFullGridPlacement (*totalEz, false);
       }
 
       if (doNeedHx)
       {
-        *totalHx = ((ParallelGrid *) Hx)->gatherFullGridPlacement (*totalHx);
+        *totalHx = ((ParallelGrid *) Hx)->gatherFullGridPlacement (*totalHx, false);
       }
       if (doNeedHy)
       {
-        *totalHy = ((ParallelGrid *) Hy)->gatherFullGridPlacement (*totalHy);
+        *totalHy = ((ParallelGrid *) Hy)->gatherFullGridPlacement (*totalHy, false);
       }
       if (doNeedHz)
       {
-        *totalHz = ((ParallelGrid *) Hz)->gatherFullGridPlacement (*totalHz);
+        *totalHz = ((ParallelGrid *) Hz)->gatherFullGridPlacement (*totalHz, false);
       }
     }
     else
     {
       if (doNeedEx)
       {
-        *totalEx = ((ParallelGrid *) Ex)->gatherFullGrid ();
+        *totalEx = ((ParallelGrid *) Ex)->gatherFullGrid (false);
       }
       if (doNeedEy)
       {
-        *totalEy = ((ParallelGrid *) Ey)->gatherFullGrid ();
+        *totalEy = ((ParallelGrid *) Ey)->gatherFullGrid (false);
       }
       if (doNeedEz)
       {
-        *totalEz = ((ParallelGrid *) Ez)->gatherFullGrid ();
+        *totalEz = ((ParallelGrid *) Ez)->gatherFullGrid (false);
       }
 
       if (doNeedHx)
       {
-        *totalHx = ((ParallelGrid *) Hx)->gatherFullGrid ();
+        *totalHx = ((ParallelGrid *) Hx)->gatherFullGrid (false);
       }
       if (doNeedHy)
       {
-        *totalHy = ((ParallelGrid *) Hy)->gatherFullGrid ();
+        *totalHy = ((ParallelGrid *) Hy)->gatherFullGrid (false);
       }
       if (doNeedHz)
       {
-        *totalHz = ((ParallelGrid *) Hz)->gatherFullGrid ();
+        *totalHz = ((ParallelGrid *) Hz)->gatherFullGrid (false);
       }
 
       *totalInitialized = true;
@@ -430,56 +430,56 @@ public:
     {
       if (doNeedEx)
       {
-        *totalEx = ((ParallelGrid *) Ex)->gatherFullGridPlacement (*totalEx);
+        *totalEx = ((ParallelGrid *) Ex)->gatherFullGridPlacement (*totalEx, false);
       }
       if (doNeedEy)
       {
-        *totalEy = ((ParallelGrid *) Ey)->gatherFullGridPlacement (*totalEy);
+        *totalEy = ((ParallelGrid *) Ey)->gatherFullGridPlacement (*totalEy, false);
       }
       if (doNeedEz)
       {
-        *totalEz = ((ParallelGrid *) Ez)->gatherFullGridPlacement (*totalEz);
+        *totalEz = ((ParallelGrid *) Ez)->gatherFullGridPlacement (*totalEz, false);
       }
 
       if (doNeedHx)
       {
-        *totalHx = ((ParallelGrid *) Hx)->gatherFullGridPlacement (*totalHx);
+        *totalHx = ((ParallelGrid *) Hx)->gatherFullGridPlacement (*totalHx, false);
       }
       if (doNeedHy)
       {
-        *totalHy = ((ParallelGrid *) Hy)->gatherFullGridPlacement (*totalHy);
+        *totalHy = ((ParallelGrid *) Hy)->gatherFullGridPlacement (*totalHy, false);
       }
       if (doNeedHz)
       {
-        *totalHz = ((ParallelGrid *) Hz)->gatherFullGridPlacement (*totalHz);
+        *totalHz = ((ParallelGrid *) Hz)->gatherFullGridPlacement (*totalHz, false);
       }
     }
     else
     {
       if (doNeedEx)
       {
-        *totalEx = ((ParallelGrid *) Ex)->gatherFullGrid ();
+        *totalEx = ((ParallelGrid *) Ex)->gatherFullGrid (false);
       }
       if (doNeedEy)
       {
-        *totalEy = ((ParallelGrid *) Ey)->gatherFullGrid ();
+        *totalEy = ((ParallelGrid *) Ey)->gatherFullGrid (false);
       }
       if (doNeedEz)
       {
-        *totalEz = ((ParallelGrid *) Ez)->gatherFullGrid ();
+        *totalEz = ((ParallelGrid *) Ez)->gatherFullGrid (false);
       }
 
       if (doNeedHx)
       {
-        *totalHx = ((ParallelGrid *) Hx)->gatherFullGrid ();
+        *totalHx = ((ParallelGrid *) Hx)->gatherFullGrid (false);
       }
       if (doNeedHy)
       {
-        *totalHy = ((ParallelGrid *) Hy)->gatherFullGrid ();
+        *totalHy = ((ParallelGrid *) Hy)->gatherFullGrid (false);
       }
       if (doNeedHz)
       {
-        *totalHz = ((ParallelGrid *) Hz)->gatherFullGrid ();
+        *totalHz = ((ParallelGrid *) Hz)->gatherFullGrid (false);
       }
 
       *totalInitialized = true;
@@ -508,56 +508,56 @@ public:
     {
       if (doNeedEx)
       {
-        *totalEx = ((ParallelGrid *) Ex)->gatherFullGridPlacement (*totalEx);
+        *totalEx = ((ParallelGrid *) Ex)->gatherFullGridPlacement (*totalEx, false);
       }
       if (doNeedEy)
       {
-        *totalEy = ((ParallelGrid *) Ey)->gatherFullGridPlacement (*totalEy);
+        *totalEy = ((ParallelGrid *) Ey)->gatherFullGridPlacement (*totalEy, false);
       }
       if (doNeedEz)
       {
-        *totalEz = ((ParallelGrid *) Ez)->gatherFullGridPlacement (*totalEz);
+        *totalEz = ((ParallelGrid *) Ez)->gatherFullGridPlacement (*totalEz, false);
       }
 
       if (doNeedHx)
       {
-        *totalHx = ((ParallelGrid *) Hx)->gatherFullGridPlacement (*totalHx);
+        *totalHx = ((ParallelGrid *) Hx)->gatherFullGridPlacement (*totalHx, false);
       }
       if (doNeedHy)
       {
-        *totalHy = ((ParallelGrid *) Hy)->gatherFullGridPlacement (*totalHy);
+        *totalHy = ((ParallelGrid *) Hy)->gatherFullGridPlacement (*totalHy, false);
       }
       if (doNeedHz)
       {
-        *totalHz = ((ParallelGrid *) Hz)->gatherFullGridPlacement (*totalHz);
+        *totalHz = ((ParallelGrid *) Hz)->gatherFullGridPlacement (*totalHz, false);
       }
     }
     else
     {
       if (doNeedEx)
       {
-        *totalEx = ((ParallelGrid *) Ex)->gatherFullGrid ();
+        *totalEx = ((ParallelGrid *) Ex)->gatherFullGrid (false);
       }
       if (doNeedEy)
       {
-        *totalEy = ((ParallelGrid *) Ey)->gatherFullGrid ();
+        *totalEy = ((ParallelGrid *) Ey)->gatherFullGrid (false);
       }
       if (doNeedEz)
       {
-        *totalEz = ((ParallelGrid *) Ez)->gatherFullGrid ();
+        *totalEz = ((ParallelGrid *) Ez)->gatherFullGrid (false);
       }
 
       if (doNeedHx)
       {
-        *totalHx = ((ParallelGrid *) Hx)->gatherFullGrid ();
+        *totalHx = ((ParallelGrid *) Hx)->gatherFullGrid (false);
       }
       if (doNeedHy)
       {
-        *totalHy = ((ParallelGrid *) Hy)->gatherFullGrid ();
+        *totalHy = ((ParallelGrid *) Hy)->gatherFullGrid (false);
       }
       if (doNeedHz)
       {
-        *totalHz = ((ParallelGrid *) Hz)->gatherFullGrid ();
+        *totalHz = ((ParallelGrid *) Hz)->gatherFullGrid (false);
       }
 
       *totalInitialized = true;
@@ -591,6 +591,42 @@ public:
     *fieldValue = FieldValueHelpers::getFieldValueRealOnly (val);
   }
 
+  /**
+   * Compute coefficients of recursive convolution of CPML for point at the specified depth in PML. Stretching of
+   * coordinate in CPML is s = kappa + sigma / (alpha + j * omega * eps0) (complex frequency shifted PML), sigma and
+   * kappa are graded polynomially from interface with interior, alpha is graded linearly from its maximum value at
+   * interface with interior to 0 at outer border.
+   */
+  static void initCPML (FPValue *b, /**< out: coefficient b */
+                        FPValue *c, /**< out: coefficient c */
+                        FPValue *kappaInv, /**< out: inverse of kappa */
+                        FPValue dist, /**< depth of point in PML (in grid steps), positive */
+                        FPValue boundary, /**< size of PML (in grid steps) */
+                        FPValue gridStep, /**< dx */
+                        FPValue gridTimeStep) /**< dt */
+  {
+    FPValue eps0 = PhysicsConst::Eps0;
+    FPValue mu0 = PhysicsConst::Mu0;
+
+    ASSERT (dist > 0 && boundary > 0);
+
+    FPValue exponent = 3;
+    FPValue sigmaMax = FPValue (0.8) * (exponent + 1) / (sqrt (mu0 / eps0) * gridStep);
+    FPValue kappaMax = SOLVER_SETTINGS.getCPMLKappaMax ();
+    FPValue alphaMax = SOLVER_SETTINGS.getCPMLAlphaMax ();
+
+    FPValue depth = dist < boundary ? dist / boundary : FPValue (1);
+    FPValue grading = pow (depth, exponent);
+
+    FPValue sigma = sigmaMax * grading;
+    FPValue kappa = 1 + (kappaMax - 1) * grading;
+    FPValue alpha = alphaMax * (1 - depth);
+
+    *b = exp (- (sigma / kappa + alpha) * gridTimeStep / eps0);
+    *c = sigma * (*b - 1) / (kappa * (sigma + kappa * alpha));
+    *kappaInv = 1 / kappa;
+  }
+
   template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
   static
   void initSigmaX (YeeGridLayout<Type, TCoord, layout_type> *layout, FPValue dx, Grid< TCoord<grid_coord, true> > *sigma)
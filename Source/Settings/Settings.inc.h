@@ -107,6 +107,7 @@ SETTINGS_ELEM_FIELD_TYPE_INT(bufferSize, getBufferSize, int, 1, "--buffer-size",
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseManualVirtualTopology, getDoUseManualVirtualTopology, bool, false, "--manual-topology", "Use manual topology for parallel grid")
 SETTINGS_ELEM_FIELD_TYPE_COORDINATE(topologySize, getTopologySize, int, 1, "--topology-size", "Size of virtual topology")
 SETTINGS_ELEM_OPTION_TYPE_NONE("--same-size-topology", "Use size of topology by x coordinate for y and z coordinates too")
+SETTINGS_ELEM_FIELD_TYPE_INT(numThreads, getNumThreads, int, 0, "--num-threads", "Number of OpenMP threads to use in computations in each process (0 to use OpenMP default)")
 
 /*
  * CUDA
@@ -123,6 +124,9 @@ SETTINGS_ELEM_FIELD_TYPE_NONE(doUseDoubleMaterialPrecision, getDoUseDoubleMateri
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseTFSF, getDoUseTFSF, bool, false, "--use-tfsf", "Use TF/SF")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseNTFF, getDoUseNTFF, bool, false, "--use-ntff", "Use NTFF")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUsePML, getDoUsePML, bool, false, "--use-pml", "Use PML")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCPML, getDoUseCPML, bool, false, "--use-cpml", "Use convolutional PML (CPML) with recursive convolution instead of split auxiliary D/B fields in PML")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(cpmlKappaMax, getCPMLKappaMax, FPValue, 1.0, "--cpml-kappa-max", "Maximum value of real coordinate stretching kappa of CPML, which is graded polynomially from 1 at interface with interior")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(cpmlAlphaMax, getCPMLAlphaMax, FPValue, 0.05, "--cpml-alpha-max", "Maximum value of complex frequency shift alpha of CPML (S/m), which is graded linearly from this value at interface with interior to 0 at outer border")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseMetamaterials, getDoUseMetamaterials, bool, false, "--use-metamaterials", "Use Metamaterials")
 
 /*
@@ -316,6 +320,14 @@ SETTINGS_ELEM_FIELD_TYPE_NONE(doCheckEnablingConditions, getDoCheckEnablingCondi
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCaCbGrids, getDoUseCaCbGrids, bool, false, "--use-ca-cb", "Use helper grids (Ca, Cb, Da, Db) with precomputed values for general FDTD computation")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCaCbPMLGrids, getDoUseCaCbPMLGrids, bool, false, "--use-ca-cb-pml", "Use helper grids (Ca, Cb, Cc, Da, Db, Dc) with precomputed values for PML FDTD computation")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCaCbPMLMetaGrids, getDoUseCaCbPMLMetaGrids, bool, false, "--use-ca-cb-pml-metamaterials", "Use helper grids (B0, B1, B2, A1, A2) with precomputed values for PML metamaterials FDTD computation")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCaCbClasses, getDoUseCaCbClasses, bool, false, "--use-ca-cb-classes", "Use compact per-point classes of materials with table of Ca and Cb coefficients for general FDTD computation (ignored with --use-ca-cb)")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCompactMaterials, getDoUseCompactMaterials, bool, false, "--use-compact-materials", "Store grids of materials as indexes in tables of distinct values after initialization (single value for uniform grids)")
+
+/*
+ * FDTD kernels
+ */
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUsePerPointKernels, getDoUsePerPointKernels, bool, false, "--use-per-point-kernels", "Use per-point kernels instead of row kernels for general FDTD computation (e.g. for validation)")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseActiveRegion, getDoUseActiveRegion, bool, false, "--use-active-region", "Update fields only in bounding box of points, which might have non-zero values (box is seeded from sources, TF/SF box and initial values, and grows by one cell on each half step)")
 
 /*
  * Layout
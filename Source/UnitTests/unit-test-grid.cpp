@@ -95,6 +95,94 @@ void testFunc (TCoord overallSize, int storedSteps, CoordinateType ct1, Coordina
   }
 
   ASSERT (grid.getRaw (0)->get (zero) == grid.getFieldValue (zero, 0));
+
+  /*
+   * Grid, which is updated in place
+   */
+  {
+    Grid<TCoord> gridInPlace (overallSize, storedSteps, true, "InPlace");
+    ASSERT (gridInPlace.getIsInPlace ());
+    ASSERT (gridInPlace.getCountStoredSteps () == storedSteps);
+    ASSERT (gridInPlace.getCountAllocatedSteps () == 1);
+
+    gridInPlace.setFieldValue (FIELDVALUE (1502, 189), test_coord, 0);
+    gridInPlace.shiftInTime ();
+    for (int i = 0; i < storedSteps; ++i)
+    {
+      ASSERT (*gridInPlace.getFieldValue (test_coord, i) == FIELDVALUE (1502, 189));
+    }
+  }
+
+  /*
+   * Partial grid, which stores values only in two boxes
+   */
+  {
+    TCoord boxEnd1 = TCoord::initAxesCoordinate (8, 8, 8, ct1, ct2, ct3);
+    TCoord notStored = TCoord::initAxesCoordinate (10, 10, 10, ct1, ct2, ct3);
+
+    std::vector<TCoord> boxStart;
+    std::vector<TCoord> boxEnd;
+    boxStart.push_back (zero);
+    boxEnd.push_back (boxEnd1);
+    boxStart.push_back (test_coord);
+    boxEnd.push_back (overallSize);
+
+    Grid<TCoord> gridPartial (overallSize, storedSteps, boxStart, boxEnd, "Partial");
+    ASSERT (gridPartial.getIsPartial ());
+    ASSERT (gridPartial.getCountAllocatedValues ()
+            == (boxEnd1.calculateTotalCoord () + (overallSize - test_coord).calculateTotalCoord ()) * storedSteps);
+
+    ASSERT (gridPartial.isStored (zero));
+    ASSERT (gridPartial.isStored (test_coord));
+    ASSERT (!gridPartial.isStored (notStored));
+    ASSERT (gridPartial.getFieldValueOrNullByAbsolutePos (notStored, 0) == NULLPTR);
+
+    for (int i = 0; i < storedSteps; ++i)
+    {
+      gridPartial.setFieldValue (FIELDVALUE (1502 * i, 189 * i), test_coord, i);
+      gridPartial.setFieldValue (FIELDVALUE (15 * i, 18 * i), zero, i);
+    }
+
+    gridPartial.shiftInTime ();
+    for (int j = 1; j < storedSteps; ++j)
+    {
+      int i = j - 1;
+      ASSERT (*gridPartial.getFieldValue (test_coord, j) == FIELDVALUE (1502 * i, 189 * i));
+      ASSERT (*gridPartial.getFieldValue (zero, j) == FIELDVALUE (15 * i, 18 * i));
+    }
+
+    gridPartial.initialize (FIELDVALUE (127, 1982));
+    ASSERT (*gridPartial.getFieldValue (zero, 0) == FIELDVALUE (127, 1982));
+    ASSERT (*gridPartial.getFieldValueOrNullByAbsolutePos (test_coord, 0) == FIELDVALUE (127, 1982));
+    ASSERT (!gridPartial.compact ());
+  }
+
+  /*
+   * Compact grid with single value, with few values and with many values
+   */
+  for (int values = 1; values <= 1000; values *= 10)
+  {
+    Grid<TCoord> gridCompact (overallSize, 1);
+    for (iter = gridCompact.begin (); iter != iter_end; ++iter)
+    {
+      TCoord pos = iter.getPos ();
+      grid_coord i = pos.calculateTotalCoord () % values;
+      gridCompact.setFieldValue (FIELDVALUE (12 * i, 7 * i), pos, 0);
+    }
+
+    ASSERT (storedSteps == 1 || !grid.compact ());
+    ASSERT (gridCompact.compact ());
+    ASSERT (gridCompact.getIsCompact ());
+    ASSERT (!gridCompact.compact ());
+
+    for (iter = gridCompact.begin (); iter != iter_end; ++iter)
+    {
+      TCoord pos = iter.getPos ();
+      grid_coord i = pos.calculateTotalCoord () % values;
+      ASSERT (*gridCompact.getFieldValue (pos, 0) == FIELDVALUE (12 * i, 7 * i));
+      ASSERT (*gridCompact.getFieldValueByAbsolutePos (pos, 0) == FIELDVALUE (12 * i, 7 * i));
+    }
+  }
 }
 
 int main (int argc, char** argv)
@@ -127,6 +215,19 @@ int main (int argc, char** argv)
     VectorFieldValues<GridCoordinate1D>::Iterator iter1 = iter;
     ALWAYS_ASSERT (iter1 == iter);
 
+    {
+      GridCoordinate1D start (1, CoordinateType::X);
+      GridCoordinate1D end (5, CoordinateType::X);
+      VectorFieldValues<GridCoordinate1D>::Iterator iterBox (start, start, end);
+      VectorFieldValues<GridCoordinate1D>::Iterator iterBox_end = VectorFieldValues<GridCoordinate1D>::Iterator::getEndIterator (start, end);
+      grid_coord index = 0;
+      for (; iterBox != iterBox_end; ++iterBox, ++index)
+      {
+        ALWAYS_ASSERT (VectorFieldValues<GridCoordinate1D>::getPosition (start, end, index) == iterBox.getPos ());
+      }
+      ALWAYS_ASSERT (index == (end - start).calculateTotalCoord ());
+    }
+
     VectorFieldValues<GridCoordinate1D> vector (GridCoordinate1D (4, CoordinateType::X));
     ALWAYS_ASSERT (vector.getSize () == GridCoordinate1D (4, CoordinateType::X));
     iter = vector.begin ();
@@ -195,6 +296,19 @@ int main (int argc, char** argv)
     VectorFieldValues<GridCoordinate2D>::Iterator iter1 = iter;
     ALWAYS_ASSERT (iter1 == iter);
 
+    {
+      GridCoordinate2D start (1, 2, CoordinateType::X, CoordinateType::Y);
+      GridCoordinate2D end (4, 5, CoordinateType::X, CoordinateType::Y);
+      VectorFieldValues<GridCoordinate2D>::Iterator iterBox (start, start, end);
+      VectorFieldValues<GridCoordinate2D>::Iterator iterBox_end = VectorFieldValues<GridCoordinate2D>::Iterator::getEndIterator (start, end);
+      grid_coord index = 0;
+      for (; iterBox != iterBox_end; ++iterBox, ++index)
+      {
+        ALWAYS_ASSERT (VectorFieldValues<GridCoordinate2D>::getPosition (start, end, index) == iterBox.getPos ());
+      }
+      ALWAYS_ASSERT (index == (end - start).calculateTotalCoord ());
+    }
+
     VectorFieldValues<GridCoordinate2D> vector (GridCoordinate2D (4, 4, CoordinateType::X, CoordinateType::Y));
     ALWAYS_ASSERT (vector.getSize () == GridCoordinate2D (4, 4, CoordinateType::X, CoordinateType::Y));
     iter = vector.begin ();
@@ -214,7 +328,10 @@ int main (int argc, char** argv)
       grid_coord i = pos.get1 ();
       grid_coord j = pos.get2 ();
       ALWAYS_ASSERT (*vector.get (pos) == FIELDVALUE (102 * i, 18 * j));
+      ALWAYS_ASSERT (vector.get (pos) == vector.getRow (i) + j);
+      ALWAYS_ASSERT (vector.get (pos) == vector.getRawData () + i * vector.getStride1 () + j);
     }
+    ALWAYS_ASSERT (((size_t) vector.getRawData ()) % GRID_ALIGNMENT_CACHE_LINE == 0);
 
     vector.resizeAndEmpty (GridCoordinate2D (3, 3, CoordinateType::X, CoordinateType::Y));
     ALWAYS_ASSERT (vector.getSize () == GridCoordinate2D (3, 3, CoordinateType::X, CoordinateType::Y));
@@ -269,6 +386,19 @@ int main (int argc, char** argv)
     VectorFieldValues<GridCoordinate3D>::Iterator iter1 = iter;
     ALWAYS_ASSERT (iter1 == iter);
 
+    {
+      GridCoordinate3D start (1, 2, 0, CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+      GridCoordinate3D end (3, 5, 4, CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+      VectorFieldValues<GridCoordinate3D>::Iterator iterBox (start, start, end);
+      VectorFieldValues<GridCoordinate3D>::Iterator iterBox_end = VectorFieldValues<GridCoordinate3D>::Iterator::getEndIterator (start, end);
+      grid_coord index = 0;
+      for (; iterBox != iterBox_end; ++iterBox, ++index)
+      {
+        ALWAYS_ASSERT (VectorFieldValues<GridCoordinate3D>::getPosition (start, end, index) == iterBox.getPos ());
+      }
+      ALWAYS_ASSERT (index == (end - start).calculateTotalCoord ());
+    }
+
     VectorFieldValues<GridCoordinate3D> vector (GridCoordinate3D (4, 4, 4, CoordinateType::X, CoordinateType::Y, CoordinateType::Z));
     ALWAYS_ASSERT (vector.getSize () == GridCoordinate3D (4, 4, 4, CoordinateType::X, CoordinateType::Y, CoordinateType::Z));
     iter = vector.begin ();
@@ -290,7 +420,10 @@ int main (int argc, char** argv)
       grid_coord j = pos.get2 ();
       grid_coord k = pos.get3 ();
       ALWAYS_ASSERT (*vector.get (pos) == FIELDVALUE (102 * i + 7 * k, 18 * j + k));
+      ALWAYS_ASSERT (vector.get (pos) == vector.getRow (i, j) + k);
+      ALWAYS_ASSERT (vector.get (pos) == vector.getRawData () + i * vector.getStride1 () + j * vector.getStride2 () + k);
     }
+    ALWAYS_ASSERT (((size_t) vector.getRawData ()) % GRID_ALIGNMENT_CACHE_LINE == 0);
 
     vector.resizeAndEmpty (GridCoordinate3D (3, 3, 3, CoordinateType::X, CoordinateType::Y, CoordinateType::Z));
     ALWAYS_ASSERT (vector.getSize () == GridCoordinate3D (3, 3, 3, CoordinateType::X, CoordinateType::Y, CoordinateType::Z));
@@ -194,6 +194,45 @@ void testFuncInternal (FPValue incAngle1, FPValue incAngle2, FPValue incAngle3,
   ALWAYS_ASSERT (layout.getLeftBorderPML () == layout.getSizePML ());
   ALWAYS_ASSERT (layout.getRightBorderPML () + layout.getSizePML () == layout.getSize ());
 
+  /*
+   * All points, which need TF/SF update, should be in the TF/SF shell, and points of PML-free box should not be in PML
+   */
+  GridCoordinate3D size3D = expandTo3D (size, ct1, ct2, ct3);
+  for (grid_coord i = 0; i < (size3D.get1 () > 0 ? size3D.get1 () : 1); ++i)
+  for (grid_coord j = 0; j < (size3D.get2 () > 0 ? size3D.get2 () : 1); ++j)
+  for (grid_coord k = 0; k < (size3D.get3 () > 0 ? size3D.get3 () : 1); ++k)
+  {
+    TCoord<grid_coord, true> pos = TCoord<grid_coord, true>::initAxesCoordinate (i, j, k, ct1, ct2, ct3);
+
+    LayoutDirection directions[] = { LayoutDirection::LEFT, LayoutDirection::RIGHT, LayoutDirection::DOWN,
+                                     LayoutDirection::UP, LayoutDirection::BACK, LayoutDirection::FRONT };
+
+    bool doNeedUpdate = false;
+    for (int dir = 0; dir < 6; ++dir)
+    {
+      LayoutDirection direction = directions[dir];
+      doNeedUpdate = doNeedUpdate
+                     || layout.doNeedTFSFUpdateExBorder (pos, direction)
+                     || layout.doNeedTFSFUpdateEyBorder (pos, direction)
+                     || layout.doNeedTFSFUpdateEzBorder (pos, direction)
+                     || layout.doNeedTFSFUpdateHxBorder (pos, direction)
+                     || layout.doNeedTFSFUpdateHyBorder (pos, direction)
+                     || layout.doNeedTFSFUpdateHzBorder (pos, direction);
+    }
+
+    if (doNeedUpdate)
+    {
+      ALWAYS_ASSERT (pos >= layout.getTFSFShellOuterStart () && pos < layout.getTFSFShellOuterEnd ());
+      ALWAYS_ASSERT (!(pos >= layout.getTFSFShellInnerStart () && pos < layout.getTFSFShellInnerEnd ()));
+    }
+
+    if (pos >= layout.getPMLFreeStart () && pos < layout.getPMLFreeEnd ())
+    {
+      ALWAYS_ASSERT (!layout.isExInPML (pos) && !layout.isEyInPML (pos) && !layout.isEzInPML (pos));
+      ALWAYS_ASSERT (!layout.isHxInPML (pos) && !layout.isHyInPML (pos) && !layout.isHzInPML (pos));
+    }
+  }
+
   ALWAYS_ASSERT (layout.getIncidentWaveAngle1 () == incAngle1);
   ALWAYS_ASSERT (layout.getIncidentWaveAngle2 () == incAngle2);
   ALWAYS_ASSERT (layout.getIncidentWaveAngle3 () == incAngle3);
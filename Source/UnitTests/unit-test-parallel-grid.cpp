@@ -472,7 +472,7 @@ int main (int argc, char** argv)
   delete grid;
   grid = initGrid (overallSize, bufferSize, yeeLayout.getSizeForCurNode (), true);
 
-  ParallelGridBase *gridTotal = grid->gatherFullGrid ();
+  ParallelGridBase *gridTotal = grid->gatherFullGrid (true);
 
 #if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
   for (grid_coord i = 0; i < grid->getSize ().get1 (); ++i)
@@ -594,6 +594,29 @@ int main (int argc, char** argv)
     }
   }
 
+  /*
+   * Check that full grid gathered only on root node is the same
+   */
+  ParallelGridBase *gridRoot = grid->gatherFullGrid (false);
+
+  if (ParallelGrid::getParallelCore ()->getProcessId () == 0)
+  {
+    grid_coord count = gridTotal->getSize ().calculateTotalCoord ();
+
+    for (int t = 0; t < gridTotal->getCountStoredSteps (); ++t)
+    {
+      for (grid_coord index = 0; index < count; ++index)
+      {
+        ASSERT (gridRoot->getRaw (t)->getRawData ()[index] == gridTotal->getRaw (t)->getRawData ()[index]);
+      }
+    }
+  }
+  else
+  {
+    ASSERT (gridRoot == NULLPTR);
+  }
+
+  delete gridRoot;
   delete gridTotal;
 
   MPI_Finalize();
@@ -30,6 +30,10 @@
 #include "Grid.h"
 #endif /* !PARALLEL_GRID */
 
+#ifdef OPENMP_ENABLED
+#include <omp.h>
+#endif /* OPENMP_ENABLED */
+
 #include "BMPDumper.h"
 #include "BMPLoader.h"
 #include "DATDumper.h"
@@ -1078,7 +1082,16 @@ int runMode (int argc, const char * const * argv)
     strcpy (argv2[i], argv[i]);
   }
 
+#ifdef OPENMP_ENABLED
+  /*
+   * All MPI calls are performed outside of OpenMP parallel regions, i.e. only by the main thread
+   */
+  int threadSupport;
+  MPI_Init_thread (&argc, &argv2, MPI_THREAD_FUNNELED, &threadSupport);
+  ALWAYS_ASSERT (threadSupport >= MPI_THREAD_FUNNELED);
+#else /* OPENMP_ENABLED */
   MPI_Init(&argc, &argv2);
+#endif /* !OPENMP_ENABLED */
 
 #ifdef MPI_CLOCK
   DPRINTF (LOG_LEVEL_1, "MPI_Wtime resolution %.10f (seconds)\n", MPI_Wtick ());
@@ -1162,6 +1175,19 @@ int runMode (int argc, const char * const * argv)
     }
 #endif
 
+#ifdef OPENMP_ENABLED
+    if (solverSettings.getNumThreads () > 0)
+    {
+      omp_set_num_threads (solverSettings.getNumThreads ());
+    }
+    DPRINTF (LOG_LEVEL_1, "Number of OpenMP threads: %d\n", omp_get_max_threads ());
+#else /* OPENMP_ENABLED */
+    if (solverSettings.getNumThreads () > 1)
+    {
+      ASSERT_MESSAGE ("Solver is not compiled with support of OpenMP. Recompile it with -DOPENMP_ENABLED=ON.");
+    }
+#endif /* !OPENMP_ENABLED */
+
     solverSettings.Initialize ();
 
     Scheme<Type, TCoord, layout_type > scheme (yeeLayout,